@@ -46,7 +46,9 @@ Preferences::Preferences(Preferences &&o)
       metaHoldForBadges(o.metaHoldForBadges),
       mouseSensitivity(o.mouseSensitivity),
       screensDelay(o.screensDelay),
-      outlineWidth(o.outlineWidth)
+      outlineWidth(o.outlineWidth),
+      standbyLayouts(o.standbyLayouts),
+      standbyMemory(o.standbyMemory)
 {
 }
 
@@ -59,7 +61,9 @@ Preferences::Preferences(const Preferences &o)
       metaHoldForBadges(o.metaHoldForBadges),
       mouseSensitivity(o.mouseSensitivity),
       screensDelay(o.screensDelay),
-      outlineWidth(o.outlineWidth)
+      outlineWidth(o.outlineWidth),
+      standbyLayouts(o.standbyLayouts),
+      standbyMemory(o.standbyMemory)
 {
 }
 
@@ -74,6 +78,8 @@ Preferences &Preferences::operator=(const Preferences &rhs)
     mouseSensitivity = rhs.mouseSensitivity;
     screensDelay = rhs.screensDelay;
     outlineWidth = rhs.outlineWidth;
+    standbyLayouts = rhs.standbyLayouts;
+    standbyMemory = rhs.standbyMemory;
 
     return (*this);
 }
@@ -89,6 +95,8 @@ Preferences &Preferences::operator=(Preferences &&rhs)
     mouseSensitivity = rhs.mouseSensitivity;
     screensDelay = rhs.screensDelay;
     outlineWidth = rhs.outlineWidth;
+    standbyLayouts = rhs.standbyLayouts;
+    standbyMemory = rhs.standbyMemory;
 
     return (*this);
 }
@@ -103,7 +111,9 @@ bool Preferences::operator==(const Preferences &rhs) const
             && (metaHoldForBadges == rhs.metaHoldForBadges)
             && (mouseSensitivity == rhs.mouseSensitivity)
             && (screensDelay == rhs.screensDelay)
-            && (outlineWidth == rhs.outlineWidth);
+            && (outlineWidth == rhs.outlineWidth)
+            && (standbyLayouts == rhs.standbyLayouts)
+            && (standbyMemory == rhs.standbyMemory);
 }
 
 bool Preferences::operator!=(const Preferences &rhs) const
@@ -121,7 +131,9 @@ bool Preferences::inDefaultValues() const
             && (metaHoldForBadges == METAHOLDFORBADGES)
             && (mouseSensitivity == MOUSESENSITIVITY)
             && (screensDelay == SCREENSDELAY)
-            && (outlineWidth == OUTLINEWIDTH);
+            && (outlineWidth == OUTLINEWIDTH)
+            && (standbyLayouts == STANDBYLAYOUTS)
+            && (standbyMemory == STANDBYMEMORY);
 }
 
 void Preferences::setToDefaults()
@@ -135,6 +147,8 @@ void Preferences::setToDefaults()
     mouseSensitivity = MOUSESENSITIVITY;
     screensDelay = SCREENSDELAY;
     outlineWidth = OUTLINEWIDTH;
+    standbyLayouts = STANDBYLAYOUTS;
+    standbyMemory = STANDBYMEMORY;
 }
 
 
@@ -38,6 +38,8 @@ public:
     static const bool METAHOLDFORBADGES = true;
     static const int SCREENSDELAY = 2500;
     static const int OUTLINEWIDTH = 1;
+    static const int STANDBYLAYOUTS = 0;
+    static const int STANDBYMEMORY = 64;
     static const Settings::MouseSensitivity MOUSESENSITIVITY = Settings::HighMouseSensitivity;
 
     Preferences();
@@ -53,6 +55,8 @@ public:
     bool metaHoldForBadges{METAHOLDFORBADGES};
     int screensDelay{SCREENSDELAY};
     int outlineWidth{OUTLINEWIDTH};
+    int standbyLayouts{STANDBYLAYOUTS};
+    int standbyMemory{STANDBYMEMORY};
     Settings::MouseSensitivity mouseSensitivity{MOUSESENSITIVITY};
 
     bool inDefaultValues() const;
@@ -56,6 +56,7 @@ void CentralLayout::init()
     connect(this, &GenericLayout::activitiesChanged, this, &CentralLayout::saveConfig);
     connect(this, &CentralLayout::disableBordersForMaximizedWindowsChanged, this, &CentralLayout::saveConfig);
     connect(this, &CentralLayout::showInMenuChanged, this, &CentralLayout::saveConfig);
+    connect(this, &GenericLayout::layoutFileSynced, this, &CentralLayout::updateMetadataIndex);
 }
 
 void CentralLayout::initToCorona(Latte::Corona *corona)
@@ -66,6 +67,12 @@ void CentralLayout::initToCorona(Latte::Corona *corona)
     }
 }
 
+void CentralLayout::restoreFromStandby()
+{
+    updateLastUsedActivity();
+    emit appliedActivitiesChanged();
+}
+
 bool CentralLayout::disableBordersForMaximizedWindows() const
 {
     return m_disableBordersForMaximizedWindows;
@@ -173,6 +180,17 @@ void CentralLayout::saveConfig()
     m_layoutGroup.writeEntry("showInMenu", m_showInMenu);
     m_layoutGroup.writeEntry("disableBordersForMaximizedWindows", m_disableBordersForMaximizedWindows);
     m_layoutGroup.writeEntry("activities", m_activities);
+
+    updateMetadataIndex();
+}
+
+void CentralLayout::updateMetadataIndex()
+{
+    if (!m_corona || !m_corona->layoutsManager()) {
+        return;
+    }
+
+    m_corona->layoutsManager()->synchronizer()->updateLayoutMetadata(data());
 }
 
 //! OVERRIDES
@@ -53,6 +53,8 @@ public:
     ~CentralLayout() override;
 
     void initToCorona(Latte::Corona *corona);
+    //! the layout is active again after it was kept in warm standby
+    void restoreFromStandby();
 
     bool disableBordersForMaximizedWindows() const;
     void setDisableBordersForMaximizedWindows(bool disable);
@@ -82,6 +84,7 @@ signals:
 private slots:
     void loadConfig();
     void saveConfig();
+    void updateMetadataIndex();
 
 private:
     void init();
@@ -44,12 +44,22 @@
 // KDE
 #include <KConfigGroup>
 
+#define LAYOUTSYNCINTERVAL 2000
+
 namespace Latte {
 namespace Layout {
 
 GenericLayout::GenericLayout(QObject *parent, QString layoutFile, QString assignedName)
     : AbstractLayout (parent, layoutFile, assignedName)
 {
+    m_syncTimer.setSingleShot(true);
+    m_syncTimer.setInterval(LAYOUTSYNCINTERVAL);
+    connect(&m_syncTimer, &QTimer::timeout, this, [&]() {
+        if (m_corona) {
+            Layouts::Storage::self()->syncToLayoutFile(this, false);
+            emit layoutFileSynced();
+        }
+    });
 }
 
 GenericLayout::~GenericLayout()
@@ -1040,7 +1050,7 @@ void GenericLayout::assignToLayout(Latte::View *latteView, QList<Plasma::Contain
 
     //! sync the original layout file for integrity
     if (m_corona && m_corona->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
-        Layouts::Storage::self()->syncToLayoutFile(this, false);
+        scheduleSyncToLayoutFile();
     }
 }
 
@@ -1078,7 +1088,7 @@ QList<Plasma::Containment *> GenericLayout::unassignFromLayout(Latte::View *latt
 
     //! sync the original layout file for integrity
     if (m_corona && m_corona->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
-        Layouts::Storage::self()->syncToLayoutFile(this, false);
+        scheduleSyncToLayoutFile();
     }
 
     return containments;
@@ -1662,8 +1672,17 @@ void GenericLayout::unlock()
 
 void GenericLayout::syncToLayoutFile(bool removeLayoutId)
 {
+    //! explicit syncs are written immediately and cover any pending one
+    m_syncTimer.stop();
+
     syncSettings();
     Layouts::Storage::self()->syncToLayoutFile(this, removeLayoutId);
+    emit layoutFileSynced();
+}
+
+void GenericLayout::scheduleSyncToLayoutFile()
+{
+    m_syncTimer.start();
 }
 
 void GenericLayout::copyView(Plasma::Containment *containment)
@@ -29,6 +29,7 @@
 #include <QQuickView>
 #include <QPointer>
 #include <QScreen>
+#include <QTimer>
 
 // Plasma
 #include <Plasma>
@@ -112,6 +113,8 @@ public:
     virtual void syncLatteViewsToScreens(Layout::ViewsMap *occupiedMap = nullptr);
 
     void syncToLayoutFile(bool removeLayoutId = false);
+    //! write-behind sync, changes that happen close together are written once
+    void scheduleSyncToLayoutFile();
 
     void lock(); //! make it only read-only
     void renameLayout(QString newName);
@@ -154,9 +157,15 @@ public slots:
 
 signals:
     void activitiesChanged(); // to move at an interface
+    //! the layout activities did not change but the activities that are applied
+    //! to its views must be evaluated again, e.g. when it is restored from standby
+    void appliedActivitiesChanged();
     void viewsCountChanged();
     void viewEdgeChanged();
 
+    //! layout settings were written to the layout file
+    void layoutFileSynced();
+
     //! used from ConfigView(s) in order to be informed which is one should be shown
     void lastConfigViewForChanged(Latte::View *view);
 
@@ -211,6 +220,8 @@ private:
     //! try to avoid crashes from recreating the same views all the time
     QList<const Plasma::Containment *> m_viewsToRecreate;
 
+    QTimer m_syncTimer;
+
     friend class Latte::View;
 };
 
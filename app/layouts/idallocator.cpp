@@ -0,0 +1,72 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "idallocator.h"
+
+namespace Latte {
+namespace Layouts {
+
+const int IdAllocator::IDLIMIT = 32000;
+
+IdAllocator::IdAllocator()
+    : m_usedIds(IDLIMIT)
+{
+}
+
+void IdAllocator::reserve(const int id)
+{
+    if (id >= 0 && id < IDLIMIT) {
+        m_usedIds.setBit(id);
+    }
+}
+
+void IdAllocator::reserve(const QStringList &ids)
+{
+    for (const auto &idStr : ids) {
+        bool ok{false};
+        int id = idStr.toInt(&ok);
+
+        if (ok) {
+            reserve(id);
+        }
+    }
+}
+
+int IdAllocator::next(const int base)
+{
+    int i = qMax(0, m_cursors.value(base, base));
+
+    while (i < IDLIMIT && m_usedIds.testBit(i)) {
+        ++i;
+    }
+
+    if (i >= IDLIMIT) {
+        m_cursors[base] = IDLIMIT;
+        return -1;
+    }
+
+    m_usedIds.setBit(i);
+    m_cursors[base] = i + 1;
+
+    return i;
+}
+
+}
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LAYOUTSIDALLOCATOR_H
+#define LAYOUTSIDALLOCATOR_H
+
+// Qt
+#include <QBitArray>
+#include <QHash>
+#include <QStringList>
+
+namespace Latte {
+namespace Layouts {
+
+//! IdAllocator mints unique containment and applet ids. Used ids are
+//! tracked in a bitset and each base keeps its own cursor, so the next
+//! free id is found in amortized constant time instead of probing
+//! every candidate against the known ids lists
+class IdAllocator
+{
+public:
+    static const int IDLIMIT;
+
+    IdAllocator();
+
+    void reserve(const int id);
+    void reserve(const QStringList &ids);
+
+    //! returns the first free id that is equal or greater than base,
+    //! or a negative value when no ids are available any more
+    int next(const int base);
+
+private:
+    QBitArray m_usedIds;
+    //! base, first id that has not been investigated yet for that base
+    QHash<int, int> m_cursors;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "metadataindex.h"
+
+// local
+#include "../layout/centrallayout.h"
+
+// Qt
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+//! increase it when the index format or the layouts metadata change
+#define INDEXVERSION 1
+#define INDEXFILE "lattedock/layoutsmetadata.index"
+#define INDEXSAVEINTERVAL 1000
+
+namespace Latte {
+namespace Layouts {
+
+MetadataIndex::MetadataIndex(QObject *parent)
+    : QObject(parent)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(INDEXSAVEINTERVAL);
+    connect(&m_saveTimer, &QTimer::timeout, this, &MetadataIndex::save);
+
+    load();
+}
+
+MetadataIndex::~MetadataIndex()
+{
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+        save();
+    }
+}
+
+Data::Layout MetadataIndex::layout(const QString &file)
+{
+    QFileInfo info(file);
+
+    if (!info.exists()) {
+        if (m_entries.remove(file) > 0) {
+            scheduleSave();
+        }
+
+        CentralLayout central(this, file);
+        return central.data();
+    }
+
+    qint64 modified = info.lastModified().toMSecsSinceEpoch();
+    qint64 size = info.size();
+
+    if (!m_entries.contains(file) || m_entries[file].modified != modified || m_entries[file].size != size) {
+        qDebug() << "Layouts metadata index, parsing layout file :: " << file;
+
+        IndexEntry entry;
+        entry.modified = modified;
+        entry.size = size;
+
+        CentralLayout central(this, file);
+        entry.data = central.data();
+
+        m_entries[file] = entry;
+        scheduleSave();
+    }
+
+    Data::Layout data = m_entries[file].data;
+
+    //! permissions changes do not update the modification time
+    data.isLocked = !info.isWritable();
+    data.isActive = false;
+
+    return data;
+}
+
+void MetadataIndex::update(const Data::Layout &layout)
+{
+    QFileInfo info(layout.id);
+
+    if (layout.id.isEmpty() || !info.exists()) {
+        return;
+    }
+
+    IndexEntry entry;
+    entry.modified = info.lastModified().toMSecsSinceEpoch();
+    entry.size = info.size();
+    entry.data = layout;
+    entry.data.isActive = false;
+
+    m_entries[layout.id] = entry;
+    scheduleSave();
+}
+
+void MetadataIndex::prune(const QStringList &files)
+{
+    bool changed{false};
+
+    for (const auto &file : m_entries.keys()) {
+        if (!files.contains(file)) {
+            m_entries.remove(file);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        scheduleSave();
+    }
+}
+
+QString MetadataIndex::indexFilePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + QStringLiteral(INDEXFILE);
+}
+
+void MetadataIndex::scheduleSave()
+{
+    m_saveTimer.start();
+}
+
+void MetadataIndex::load()
+{
+    QFile file(indexFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    qint32 version{0};
+    qint32 count{0};
+    in >> version >> count;
+
+    if (version != INDEXVERSION) {
+        return;
+    }
+
+    for (int i=0; i<count && in.status() == QDataStream::Ok; ++i) {
+        IndexEntry entry;
+        qint32 backgroundStyle{0};
+
+        in >> entry.modified >> entry.size
+           >> entry.data.id >> entry.data.name >> entry.data.icon >> entry.data.color >> entry.data.background
+           >> entry.data.textColor >> entry.data.lastUsedActivity >> entry.data.activities >> backgroundStyle
+           >> entry.data.isBroken >> entry.data.isShownInMenu >> entry.data.hasDisabledBorders;
+
+        if (in.status() != QDataStream::Ok) {
+            break;
+        }
+
+        entry.data.backgroundStyle = static_cast<Latte::Layout::BackgroundStyle>(backgroundStyle);
+        m_entries[entry.data.id] = entry;
+    }
+}
+
+void MetadataIndex::save()
+{
+    QString filePath = indexFilePath();
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+
+    out << (qint32)INDEXVERSION << (qint32)m_entries.count();
+
+    for (const auto &entry : m_entries) {
+        out << entry.modified << entry.size
+            << entry.data.id << entry.data.name << entry.data.icon << entry.data.color << entry.data.background
+            << entry.data.textColor << entry.data.lastUsedActivity << entry.data.activities << (qint32)entry.data.backgroundStyle
+            << entry.data.isBroken << entry.data.isShownInMenu << entry.data.hasDisabledBorders;
+    }
+
+    file.commit();
+}
+
+}
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LAYOUTSMETADATAINDEX_H
+#define LAYOUTSMETADATAINDEX_H
+
+// local
+#include "../data/layoutdata.h"
+
+// Qt
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+
+
+namespace Latte {
+namespace Layouts {
+
+//! MetadataIndex keeps the layouts metadata (name, activities, colors,
+//! backgrounds etc.) of all layout files in a single index file. Layout
+//! files are parsed only when they changed since they were indexed.
+class MetadataIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    MetadataIndex(QObject *parent);
+    ~MetadataIndex() override;
+
+    //! metadata of the provided layout file, files that changed since they
+    //! were indexed and were not updated explicitly are parsed again
+    Data::Layout layout(const QString &file);
+
+    //! layouts update their metadata explicitly when they are saved, so
+    //! edits that do not change the file size or modification time are not lost
+    void update(const Data::Layout &layout);
+
+    //! forget layout files that do not exist any more
+    void prune(const QStringList &files);
+
+private:
+    struct IndexEntry {
+        qint64 modified{0};
+        qint64 size{0};
+        Data::Layout data;
+    };
+
+    QString indexFilePath() const;
+
+    void load();
+    void save();
+    void scheduleSave();
+
+private:
+    //! layout file, metadata
+    QHash<QString, IndexEntry> m_entries;
+
+    QTimer m_saveTimer;
+};
+
+}
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include "storage.h"
 
 // local
+#include "idallocator.h"
 #include "importer.h"
 #include "manager.h"
 #include "../lattecorona.h"
@@ -53,8 +54,6 @@ const int Storage::IDBASE = 0;
 
 Storage::Storage()
 {
-    qDebug() << " >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> LAYOUTS::STORAGE, TEMP DIR ::: " << m_storageTmpDir.path();
-
     SubContaimentIdentityData data;
 
     //! Systray
@@ -228,63 +227,24 @@ void Storage::importToCorona(const Layout::GenericLayout *layout)
     //! Setting mutable for create a containment
     layout->corona()->setImmutability(Plasma::Types::Mutable);
 
-    QString temp1FilePath = m_storageTmpDir.path() +  "/" + layout->name() + ".multiple.views";
-    //! we need to copy first the layout file because the kde cache
-    //! may not have yet been updated (KSharedConfigPtr)
-    //! this way we make sure at the latest changes stored in the layout file
-    //! will be also available when changing to Multiple Layouts
-    QString tempLayoutFilePath = m_storageTmpDir.path() +  "/" + layout->name() + ".multiple.tmplayout";
-
-    //! WE NEED A WAY TO COPY A CONTAINMENT!!!!
-    QFile tempLayoutFile(tempLayoutFilePath);
-    QFile copyFile(temp1FilePath);
-    QFile layoutOriginalFile(layout->file());
-
-    if (tempLayoutFile.exists()) {
-        tempLayoutFile.remove();
-    }
-
-    if (copyFile.exists())
-        copyFile.remove();
+    //! the layout file is parsed directly and not through KSharedConfig because
+    //! the kde cache may not have yet been updated, this way we make sure that
+    //! the latest changes stored in the layout file will be also available
+    //! when changing to Multiple Layouts
+    KConfig layoutFile(layout->file(), KConfig::SimpleConfig);
+    const KConfigGroup layoutContainments = KConfigGroup(&layoutFile, "Containments");
 
-    layoutOriginalFile.copy(tempLayoutFilePath);
+    //! the containments tree with updated unique ids lives only in memory
+    KConfig memoryLayout(QString(), KConfig::SimpleConfig);
+    KConfigGroup fixedContainments = KConfigGroup(&memoryLayout, "Containments");
 
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(tempLayoutFilePath);
-    KSharedConfigPtr newFile = KSharedConfig::openConfig(temp1FilePath);
-    KConfigGroup copyGroup = KConfigGroup(newFile, "Containments");
-    KConfigGroup current_containments = KConfigGroup(filePtr, "Containments");
-
-    current_containments.copyTo(&copyGroup);
-
-    copyGroup.sync();
-
-    //! update ids to unique ones
-    QString temp2File = newUniqueIdsLayoutFromFile(layout, temp1FilePath);
+    newUniqueIdsLayout(layout, layoutContainments, fixedContainments);
 
     //! Finally import the configuration
-    importLayoutFile(layout, temp2File);
+    importLayout(layout, KConfigGroup(&memoryLayout, ""));
 }
 
 
-QString Storage::availableId(QStringList all, QStringList assigned, int base)
-{
-    bool found = false;
-
-    int i = base;
-
-    while (!found && i < 32000) {
-        QString iStr = QString::number(i);
-
-        if (!all.contains(iStr) && !assigned.contains(iStr)) {
-            return iStr;
-        }
-
-        i++;
-    }
-
-    return QString("");
-}
-
 bool Storage::appletGroupIsValid(const KConfigGroup &appletGroup)
 {
     return !( appletGroup.keyList().count() == 0
@@ -294,24 +254,16 @@ bool Storage::appletGroupIsValid(const KConfigGroup &appletGroup)
               && appletGroup.group("Configuration").hasKey("PreloadWeight") );
 }
 
-QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout, QString file)
+void Storage::newUniqueIdsLayout(const Layout::GenericLayout *layout, const KConfigGroup &containments, KConfigGroup &fixedContainments)
 {
     if (!layout->corona()) {
-        return QString();
-    }
-
-    QString tempFile = m_storageTmpDir.path() + "/" + layout->name() + ".views.newids";
-
-    QFile copyFile(tempFile);
-
-    if (copyFile.exists()) {
-        copyFile.remove();
+        return;
     }
 
-    //! BEGIN updating the ids in the temp file
-    QStringList allIds;
-    allIds << layout->corona()->containmentsIds();
-    allIds << layout->corona()->appletsIds();
+    //! BEGIN updating the ids in the containments tree
+    IdAllocator ids;
+    ids.reserve(layout->corona()->containmentsIds());
+    ids.reserve(layout->corona()->appletsIds());
 
     QStringList toInvestigateContainmentIds;
     QStringList toInvestigateAppletIds;
@@ -321,21 +273,15 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
     QHash<QString, QString> subParentContainmentIds;
     QHash<QString, QString> subAppletIds;
 
-    //qDebug() << "Ids:" << allIds;
-
     //qDebug() << "to copy containments: " << toCopyContainmentIds;
     //qDebug() << "to copy applets: " << toCopyAppletIds;
 
-    QStringList assignedIds;
     QHash<QString, QString> assigned;
 
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(file);
-    KConfigGroup investigate_conts = KConfigGroup(filePtr, "Containments");
-
     //! Record the containment and applet ids
-    for (const auto &cId : investigate_conts.groupList()) {
+    for (const auto &cId : containments.groupList()) {
         toInvestigateContainmentIds << cId;
-        auto appletsEntries = investigate_conts.group(cId).group("Applets");
+        auto appletsEntries = containments.group(cId).group("Applets");
         toInvestigateAppletIds << appletsEntries.groupList();
 
         //! investigate for subcontainments
@@ -355,20 +301,15 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
 
     //! Reassign containment and applet ids to unique ones
     for (const auto &contId : toInvestigateContainmentIds) {
-        QString newId = availableId(allIds, assignedIds, 12);
-
-        assignedIds << newId;
-        assigned[contId] = newId;
+        int newId = ids.next(12);
+        assigned[contId] = isValid(newId) ? QString::number(newId) : QString();
     }
 
     for (const auto &appId : toInvestigateAppletIds) {
-        QString newId = availableId(allIds, assignedIds, 40);
-
-        assignedIds << newId;
-        assigned[appId] = newId;
+        int newId = ids.next(40);
+        assigned[appId] = isValid(newId) ? QString::number(newId) : QString();
     }
 
-    qDebug() << "ALL CORONA IDS ::: " << allIds;
     qDebug() << "FULL ASSIGNMENTS ::: " << assigned;
 
     for (const auto &cId : toInvestigateContainmentIds) {
@@ -401,15 +342,33 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
 
     qDebug() << "FIXED FULL ASSIGNMENTS ::: " << assigned;
 
+    //! Copy the containments tree with the new ids
+    for (const auto &contId : containments.groupList()) {
+        QString pluginId = containments.group(contId).readEntry("plugin", "");
+
+        if (pluginId != "org.kde.desktopcontainment") { //!don't add ghost containments
+            KConfigGroup newContainmentGroup = fixedContainments.group(assigned[contId]);
+            containments.group(contId).copyTo(&newContainmentGroup);
+
+            newContainmentGroup.group("Applets").deleteGroup();
+
+            for (const auto &appId : containments.group(contId).group("Applets").groupList()) {
+                const KConfigGroup appletGroup = containments.group(contId).group("Applets").group(appId);
+                KConfigGroup newAppletGroup = newContainmentGroup.group("Applets").group(assigned[appId]);
+                appletGroup.copyTo(&newAppletGroup);
+            }
+        }
+    }
+
     //! update applet ids in their containment order and in MultipleLayouts update also the layoutId
-    for (const auto &cId : investigate_conts.groupList()) {
+    for (const auto &cId : fixedContainments.groupList()) {
         //! Update options that contain applet ids
         //! (appletOrder) and (lockedZoomApplets) and (userBlocksColorizingApplets)
         QStringList options;
         options << "appletOrder" << "lockedZoomApplets" << "userBlocksColorizingApplets";
 
         for (const auto &settingStr : options) {
-            QString order1 = investigate_conts.group(cId).group("General").readEntry(settingStr, QString());
+            QString order1 = fixedContainments.group(cId).group("General").readEntry(settingStr, QString());
 
             if (!order1.isEmpty()) {
                 QStringList order1Ids = order1.split(";");
@@ -420,19 +379,24 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
                 }
 
                 QString fixedOrder1 = fixedOrder1Ids.join(";");
-                investigate_conts.group(cId).group("General").writeEntry(settingStr, fixedOrder1);
+                fixedContainments.group(cId).group("General").writeEntry(settingStr, fixedOrder1);
             }
         }
 
         if (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
-            investigate_conts.group(cId).writeEntry("layoutId", layout->name());
+            fixedContainments.group(cId).writeEntry("layoutId", layout->name());
         }
     }
 
     //! must update also the sub id in its applet
     for (const auto &subId : toInvestigateSubContIds) {
-        KConfigGroup subParentContainment = investigate_conts.group(subParentContainmentIds[subId]);
-        KConfigGroup subAppletConfig = subParentContainment.group("Applets").group(subAppletIds[subId]);
+        QString parentId = assigned[subParentContainmentIds[subId]];
+
+        if (!fixedContainments.hasGroup(parentId)) {
+            continue;
+        }
+
+        KConfigGroup subAppletConfig = fixedContainments.group(parentId).group("Applets").group(assigned[subAppletIds[subId]]);
 
         int entityIndex = subIdentityIndex(subAppletConfig);
 
@@ -443,37 +407,54 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
 
             if (!m_subIdentities[entityIndex].cfgProperty.isEmpty()) {
                 subAppletConfig.writeEntry(m_subIdentities[entityIndex].cfgProperty, assigned[subId]);
-                subParentContainment.sync();
             }
         }
     }
+}
 
-    investigate_conts.sync();
+bool Storage::syncGroup(const KConfigGroup &source, KConfigGroup &target) const
+{
+    bool changed{false};
 
-    //! Copy To Temp 2 File And Update Correctly The Ids
-    KSharedConfigPtr file2Ptr = KSharedConfig::openConfig(tempFile);
-    KConfigGroup fixedNewContainmets = KConfigGroup(file2Ptr, "Containments");
+    //! entries
+    QMap<QString, QString> sourceEntries = source.entryMap();
+    QMap<QString, QString> targetEntries = target.entryMap();
 
-    for (const auto &contId : investigate_conts.groupList()) {
-        QString pluginId = investigate_conts.group(contId).readEntry("plugin", "");
+    if (sourceEntries != targetEntries) {
+        for (const auto &key : targetEntries.keys()) {
+            if (!sourceEntries.contains(key)) {
+                target.deleteEntry(key);
+            }
+        }
 
-        if (pluginId != "org.kde.desktopcontainment") { //!don't add ghost containments
-            KConfigGroup newContainmentGroup = fixedNewContainmets.group(assigned[contId]);
-            investigate_conts.group(contId).copyTo(&newContainmentGroup);
+        for (const auto &key : sourceEntries.keys()) {
+            if (!targetEntries.contains(key) || targetEntries[key] != sourceEntries[key]) {
+                target.writeEntry(key, sourceEntries[key]);
+            }
+        }
 
-            newContainmentGroup.group("Applets").deleteGroup();
+        changed = true;
+    }
 
-            for (const auto &appId : investigate_conts.group(contId).group("Applets").groupList()) {
-                KConfigGroup appletGroup = investigate_conts.group(contId).group("Applets").group(appId);
-                KConfigGroup newAppletGroup = fixedNewContainmets.group(assigned[contId]).group("Applets").group(assigned[appId]);
-                appletGroup.copyTo(&newAppletGroup);
-            }
+    //! subgroups
+    QStringList sourceGroups = source.groupList();
+
+    for (const auto &groupName : target.groupList()) {
+        if (!sourceGroups.contains(groupName)) {
+            target.group(groupName).deleteGroup();
+            changed = true;
         }
     }
 
-    fixedNewContainmets.sync();
+    for (const auto &groupName : sourceGroups) {
+        KConfigGroup targetGroup = target.group(groupName);
+
+        if (syncGroup(source.group(groupName), targetGroup)) {
+            changed = true;
+        }
+    }
 
-    return tempFile;
+    return changed;
 }
 
 void Storage::syncToLayoutFile(const Layout::GenericLayout *layout, bool removeLayoutId)
@@ -482,34 +463,40 @@ void Storage::syncToLayoutFile(const Layout::GenericLayout *layout, bool removeL
         return;
     }
 
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(layout->file());
-
-    KConfigGroup oldContainments = KConfigGroup(filePtr, "Containments");
-    oldContainments.deleteGroup();
-
-    qDebug() << " LAYOUT :: " << layout->name() << " is syncing its original file.";
+    //! the current containments state is gathered in memory and only the
+    //! entries and groups that differ from the layout file are written back
+    KConfig memoryLayout(QString(), KConfig::SimpleConfig);
+    KConfigGroup newContainments = KConfigGroup(&memoryLayout, "Containments");
 
     for (const auto containment : *layout->containments()) {
         if (removeLayoutId) {
             containment->config().writeEntry("layoutId", "");
         }
 
-        KConfigGroup newGroup = oldContainments.group(QString::number(containment->id()));
+        KConfigGroup newGroup = newContainments.group(QString::number(containment->id()));
         containment->config().copyTo(&newGroup);
+        newGroup.writeEntry("layoutId", "");
+    }
 
-        if (!removeLayoutId) {
-            newGroup.writeEntry("layoutId", "");
-            newGroup.sync();
-        }
+    KSharedConfigPtr filePtr = KSharedConfig::openConfig(layout->file());
+    //! make sure that the comparison is done against the stored file
+    filePtr->reparseConfiguration();
+
+    KConfigGroup oldContainments = KConfigGroup(filePtr, "Containments");
+
+    if (!syncGroup(newContainments, oldContainments)) {
+        return;
     }
 
+    qDebug() << " LAYOUT :: " << layout->name() << " is syncing its original file.";
+
+    //! a single write for all changes
     oldContainments.sync();
 }
 
-QList<Plasma::Containment *> Storage::importLayoutFile(const Layout::GenericLayout *layout, QString file)
+QList<Plasma::Containment *> Storage::importLayout(const Layout::GenericLayout *layout, const KConfigGroup &layoutGroup)
 {
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(file);
-    auto newContainments = layout->corona()->importLayout(KConfigGroup(filePtr, ""));
+    auto newContainments = layout->corona()->importLayout(layoutGroup);
 
     qDebug() << " imported containments ::: " << newContainments.length();
 
@@ -535,16 +522,9 @@ ViewDelayedCreationData Storage::copyView(const Layout::GenericLayout *layout, P
     //! Setting mutable for create a containment
     layout->corona()->setImmutability(Plasma::Types::Mutable);
 
-    QString temp1File = m_storageTmpDir.path() +  "/" + layout->name() + ".copy.view";
-
-    //! WE NEED A WAY TO COPY A CONTAINMENT!!!!
-    QFile copyFile(temp1File);
-
-    if (copyFile.exists())
-        copyFile.remove();
-
-    KSharedConfigPtr newFile = KSharedConfig::openConfig(temp1File);
-    KConfigGroup copied_conts = KConfigGroup(newFile, "Containments");
+    //! the containment and its subcontainments are copied in memory
+    KConfig copiedLayout(QString(), KConfig::SimpleConfig);
+    KConfigGroup copied_conts = KConfigGroup(&copiedLayout, "Containments");
     KConfigGroup copied_c1 = KConfigGroup(&copied_conts, QString::number(containment->id()));
 
     containment->config().copyTo(&copied_c1);
@@ -585,10 +565,13 @@ ViewDelayedCreationData Storage::copyView(const Layout::GenericLayout *layout, P
     //! end of subcontainments specific code
 
     //! update ids to unique ones
-    QString temp2File = newUniqueIdsLayoutFromFile(layout, temp1File);
+    KConfig fixedLayout(QString(), KConfig::SimpleConfig);
+    KConfigGroup fixedContainments = KConfigGroup(&fixedLayout, "Containments");
+
+    newUniqueIdsLayout(layout, copied_conts, fixedContainments);
 
     //! Finally import the configuration
-    QList<Plasma::Containment *> importedDocks = importLayoutFile(layout, temp2File);
+    QList<Plasma::Containment *> importedDocks = importLayout(layout, KConfigGroup(&fixedLayout, ""));
 
     Plasma::Containment *newContainment{nullptr};
 
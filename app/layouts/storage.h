@@ -23,9 +23,6 @@
 // local
 #include "../data/appletdata.h"
 
-// Qt
-#include <QTemporaryDir>
-
 // KDE
 #include <KConfigGroup>
 
@@ -110,18 +107,18 @@ private:
     bool isSubContainment(const KConfigGroup &appletGroup) const;
     int subIdentityIndex(const KConfigGroup &appletGroup) const;
 
+    //! updates target to match source by writing only the entries and
+    //! groups that differ, returns true when target changed
+    bool syncGroup(const KConfigGroup &source, KConfigGroup &target) const;
+
     //! STORAGE !////
-    QString availableId(QStringList all, QStringList assigned, int base);
-    //! provides a new file path based the provided file. The new file
-    //! has updated ids for containments and applets based on the corona
-    //! loaded ones
-    QString newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout, QString file);
-    //! imports a layout file and returns the containments for the docks
-    QList<Plasma::Containment *> importLayoutFile(const Layout::GenericLayout *layout, QString file);
+    //! copies the provided containments into fixedContainments. The copied
+    //! containments and applets have updated ids based on the corona loaded ones
+    void newUniqueIdsLayout(const Layout::GenericLayout *layout, const KConfigGroup &containments, KConfigGroup &fixedContainments);
+    //! imports a layout config and returns the containments for the docks
+    QList<Plasma::Containment *> importLayout(const Layout::GenericLayout *layout, const KConfigGroup &layoutGroup);
 
 private:
-    QTemporaryDir m_storageTmpDir;
-
     QList<SubContaimentIdentityData> m_subIdentities;
 };
 
@@ -22,6 +22,7 @@
 //! local
 #include "importer.h"
 #include "manager.h"
+#include "metadataindex.h"
 #include "../apptypes.h"
 #include "../data/layoutdata.h"
 #include "../lattecorona.h"
@@ -34,6 +35,7 @@
 // Qt
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 
 // Plasma
 #include <Plasma/Containment>
@@ -44,18 +46,27 @@
 #include <KWindowSystem>
 
 #define LAYOUTSINITINTERVAL 350
+//! every view window is double buffered with 32bit pixels
+#define STANDBYVIEWBUFFERS 2
 
 namespace Latte {
 namespace Layouts {
 
 Synchronizer::Synchronizer(QObject *parent)
     : QObject(parent),
-      m_activitiesController(new KActivities::Controller)
+      m_activitiesController(new KActivities::Controller),
+      m_metadataIndex(new MetadataIndex(this))
 {
     m_manager = qobject_cast<Manager *>(parent);
 
     connect(this, &Synchronizer::layoutsChanged, this, &Synchronizer::reloadAssignedLayouts);
 
+    //! layouts settings may have changed the files of standby layouts, drop them
+    //! in order to be loaded again from their files when needed
+    connect(this, &Synchronizer::layoutsChanged, this, &Synchronizer::unloadStandbyLayouts);
+    connect(m_manager->corona()->universalSettings(), &UniversalSettings::standbyLayoutsChanged, this, &Synchronizer::updateStandbyLayouts);
+    connect(m_manager->corona()->universalSettings(), &UniversalSettings::standbyMemoryChanged, this, &Synchronizer::updateStandbyLayouts);
+
     //! KWin update Disabled Borders
     connect(this, &Synchronizer::centralLayoutsChanged, this, &Synchronizer::updateKWinDisabledBorders);
     connect(m_manager->corona()->universalSettings(), &UniversalSettings::canDisableBordersChanged, this, &Synchronizer::updateKWinDisabledBorders);
@@ -254,10 +265,24 @@ void Synchronizer::setLayoutsTable(const Data::LayoutsTable &table)
         return;
     }
 
+    //! layouts that were edited from the layouts settings
+    for (int i=0; i<table.rowCount(); ++i) {
+        const Data::Layout &layout = table[i];
+
+        if (!m_layouts.containsId(layout.id) || !(m_layouts[layout.id] == layout)) {
+            m_metadataIndex->update(layout);
+        }
+    }
+
     m_layouts = table;
     emit layoutsChanged();
 }
 
+void Synchronizer::updateLayoutMetadata(const Data::Layout &layout)
+{
+    m_metadataIndex->update(layout);
+}
+
 void Synchronizer::updateLayoutsTable()
 {
     for (int i = 0; i < m_centralLayouts.size(); ++i) {
@@ -270,8 +295,7 @@ void Synchronizer::updateLayoutsTable()
 
     for (int i = 0; i < m_layouts.rowCount(); ++i) {
         if (m_layouts[i].isBroken && !m_layouts[i].isActive) {
-            CentralLayout central(this, m_layouts[i].id);
-            m_layouts[i].isBroken = central.isBroken();
+            m_layouts[i].isBroken = m_metadataIndex->layout(m_layouts[i].id).isBroken;
         }
     }
 }
@@ -526,6 +550,7 @@ void Synchronizer::initLayouts()
     QStringList filter;
     filter.append(QString("*.layout.latte"));
     QStringList files = layoutDir.entryList(filter, QDir::Files | QDir::NoSymLinks);
+    QStringList layoutpaths;
 
     for (const auto &layout : files) {
         if (layout.contains(Layout::MULTIPLELAYOUTSHIDDENNAME)) {
@@ -534,9 +559,12 @@ void Synchronizer::initLayouts()
         }
 
         QString layoutpath = layoutDir.absolutePath() + "/" + layout;
+        layoutpaths << layoutpath;
         onLayoutAdded(layoutpath);
     }
 
+    m_metadataIndex->prune(layoutpaths);
+
     emit layoutsChanged();
 
     if (!m_isLoaded) {
@@ -548,8 +576,7 @@ void Synchronizer::initLayouts()
 
 void Synchronizer::onLayoutAdded(const QString &layout)
 {
-    CentralLayout centrallayout(this, layout);
-    m_layouts.insertBasedOnName(centrallayout.data());
+    m_layouts.insertBasedOnName(m_metadataIndex->layout(layout));
 
     if (m_isLoaded) {
         emit layoutsChanged();
@@ -573,6 +600,8 @@ void Synchronizer::reloadAssignedLayouts()
 
 void Synchronizer::unloadLayouts()
 {
+    unloadStandbyLayouts();
+
     //! Unload all CentralLayouts
     while (!m_centralLayouts.isEmpty()) {
         CentralLayout *layout = m_centralLayouts.at(0);
@@ -675,8 +704,7 @@ bool Synchronizer::switchToLayoutInMultipleModeBasedOnActivities(const QString &
         layoutdata = central->data();
     } else if (m_layouts.containsName(layoutName)) {
         QString layoutid = m_layouts.idForName(layoutName);
-        CentralLayout storagedlayout(this, layoutid);
-        layoutdata = storagedlayout.data();
+        layoutdata = m_metadataIndex->layout(layoutid);
 
         m_layouts[layoutid] = layoutdata;
     }
@@ -881,6 +909,15 @@ void Synchronizer::syncMultipleLayoutsToActivities()
     //! Add needed Layouts based on Activities settings
     for (const auto &layoutname : layoutNamesToLoad) {
         if (!centralLayout(layoutname)) {
+            CentralLayout *standby = takeStandbyLayout(layoutname);
+
+            if (standby) {
+                qDebug() << "RESTORING LAYOUT FROM STANDBY ::::: " << layoutname;
+                addLayout(standby);
+                standby->restoreFromStandby();
+                continue;
+            }
+
             CentralLayout *newLayout = new CentralLayout(this, QString(layoutPath(layoutname)), layoutname);
 
             if (newLayout) {
@@ -907,6 +944,19 @@ void Synchronizer::syncMultipleLayoutsToActivities()
 
     //! Unload no needed Layouts
 
+    //! layouts whose views are already hidden because of their stopped activities
+    //! are kept in standby instead
+    for (int i = layoutNamesToUnload.count() - 1; i >= 0; --i) {
+        CentralLayout *layout = centralLayout(layoutNamesToUnload[i]);
+
+        if (canBeInStandby(layout)) {
+            moveToStandby(layout);
+            layoutNamesToUnload.removeAt(i);
+        }
+    }
+
+    updateStandbyLayouts();
+
     //! hide layouts that will be removed in the end
     if (!layoutNamesToUnload.isEmpty()) {
         for (const auto layoutname : layoutNamesToUnload) {
@@ -952,6 +1002,136 @@ void Synchronizer::unloadLayouts(const QStringList &layoutNames)
     emit centralLayoutsChanged();
 }
 
+bool Synchronizer::canBeInStandby(CentralLayout *layout)
+{
+    if (!layout || standbyCapacity() <= 0
+            || layout->isOnAllActivities() || layout->isForFreeActivities() || layout->activities().isEmpty()) {
+        return false;
+    }
+
+    //! its views must be hidden by the window manager, meaning that none of
+    //! its activities is running
+    QStringList appliedactivities = layout->appliedActivities();
+    QStringList running = runningActivities();
+
+    if (appliedactivities.isEmpty()) {
+        return false;
+    }
+
+    for (const auto &activity : appliedactivities) {
+        if (running.contains(activity)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int Synchronizer::standbyCapacity() const
+{
+    //! Plasma wayland does not support yet Activities for windows, so
+    //! the views of standby layouts can not be hidden
+    if (KWindowSystem::isPlatformWayland() || m_manager->memoryUsage() != MemoryUsage::MultipleLayouts) {
+        return 0;
+    }
+
+    return m_manager->corona()->universalSettings()->standbyLayouts();
+}
+
+CentralLayout *Synchronizer::takeStandbyLayout(const QString &layoutName)
+{
+    for (int i = 0; i < m_standbyLayouts.size(); ++i) {
+        if (m_standbyLayouts[i]->name() == layoutName) {
+            m_standbySyncTimes.remove(m_standbyLayouts[i]);
+            return m_standbyLayouts.takeAt(i);
+        }
+    }
+
+    return nullptr;
+}
+
+qint64 Synchronizer::standbyMemoryUsage() const
+{
+    //! hidden views keep their window buffers, that is the memory that
+    //! standby layouts are keeping compared to unloaded layouts
+    qint64 bytes{0};
+
+    for (const auto layout : m_standbyLayouts) {
+        for (const auto view : layout->latteViews()) {
+            const qreal ratio = view->devicePixelRatio();
+            bytes += (qint64)(view->width() * ratio) * (qint64)(view->height() * ratio) * 4 * STANDBYVIEWBUFFERS;
+        }
+    }
+
+    return bytes;
+}
+
+void Synchronizer::moveToStandby(CentralLayout *layout)
+{
+    int posLayout = m_centralLayouts.indexOf(layout);
+
+    if (posLayout < 0) {
+        return;
+    }
+
+    qDebug() << "MOVING LAYOUT TO STANDBY ::::: " << layout->name();
+    m_centralLayouts.removeAt(posLayout);
+
+    //! the layout file must be up-to-date because standby layouts
+    //! are considered inactive and are read from their files
+    layout->syncToLayoutFile();
+    m_standbyLayouts.append(layout);
+    m_standbySyncTimes[layout] = QFileInfo(layout->file()).lastModified();
+}
+
+bool Synchronizer::standbyFileIsEdited(CentralLayout *layout) const
+{
+    //! the layout file was changed from outside, e.g. from the layouts settings,
+    //! after the layout moved to standby
+    return (QFileInfo(layout->file()).lastModified() != m_standbySyncTimes.value(layout));
+}
+
+void Synchronizer::unloadStandbyLayout(CentralLayout *layout, bool keepFileEdits)
+{
+    if (!m_standbyLayouts.removeOne(layout)) {
+        return;
+    }
+
+    qDebug() << "REMOVING STANDBY LAYOUT ::::: " << layout->name();
+
+    //! containments may have changed while the layout was in standby, such
+    //! changes are kept the same way they are for unloaded central layouts
+    if (!keepFileEdits || !standbyFileIsEdited(layout)) {
+        layout->syncToLayoutFile(true);
+    }
+
+    m_standbySyncTimes.remove(layout);
+
+    layout->unloadContainments();
+    layout->unloadLatteViews();
+    m_manager->clearUnloadedContainmentsFromLinkedFile(layout->unloadedContainmentsIds());
+    delete layout;
+}
+
+void Synchronizer::unloadStandbyLayouts()
+{
+    //! edits of the layouts settings have higher priority than the standby layouts
+    while (!m_standbyLayouts.isEmpty()) {
+        unloadStandbyLayout(m_standbyLayouts.at(0), true);
+    }
+}
+
+void Synchronizer::updateStandbyLayouts()
+{
+    int capacity = standbyCapacity();
+    qint64 budget = (qint64)m_manager->corona()->universalSettings()->standbyMemory() * 1024 * 1024;
+
+    //! least recently used layouts are released first
+    while (!m_standbyLayouts.isEmpty() && (m_standbyLayouts.count() > capacity || standbyMemoryUsage() > budget)) {
+        unloadStandbyLayout(m_standbyLayouts.at(0));
+    }
+}
+
 void Synchronizer::updateKWinDisabledBorders()
 {
     if (!m_manager->corona()->universalSettings()->canDisableBorders()) {
@@ -26,6 +26,7 @@
 #include "../data/layoutstable.h"
 
 // Qt
+#include <QDateTime>
 #include <QObject>
 #include <QHash>
 #include <QTimer>
@@ -39,6 +40,7 @@ class GenericLayout;
 }
 namespace Layouts {
 class Manager;
+class MetadataIndex;
 }
 }
 
@@ -118,6 +120,9 @@ public:
     Data::LayoutsTable layoutsTable() const;
     void setLayoutsTable(const Data::LayoutsTable &table);
 
+    //! informs the layouts metadata index for saved layouts
+    void updateLayoutMetadata(const Data::Layout &layout);
+
 public slots:
     void initLayouts();
     void updateKWinDisabledBorders();
@@ -146,6 +151,25 @@ private:
     void unloadCentralLayout(CentralLayout *layout);
     void unloadLayouts(const QStringList &layoutNames);
 
+    //! Warm standby, in MultipleLayouts mode layouts whose activities stopped are
+    //! kept loaded with their views hidden from the window manager, so starting
+    //! one of their activities again does not recreate their containments and views.
+    //! SingleLayout mode reloads the corona for every switch and it is not covered
+    void moveToStandby(CentralLayout *layout);
+    //! when keepFileEdits is true, layouts whose files were edited in the meantime
+    //! are not written back
+    void unloadStandbyLayout(CentralLayout *layout, bool keepFileEdits = false);
+    void unloadStandbyLayouts();
+    void updateStandbyLayouts();
+
+    bool canBeInStandby(CentralLayout *layout);
+    bool standbyFileIsEdited(CentralLayout *layout) const;
+    int standbyCapacity() const;
+    //! estimated bytes of the standby layouts views window buffers
+    qint64 standbyMemoryUsage() const;
+
+    CentralLayout *takeStandbyLayout(const QString &layoutName);
+
     bool initSingleMode(QString layoutName);
     bool initMultipleMode(QString layoutName);
 
@@ -164,10 +188,15 @@ private:
 
     Data::LayoutsTable m_layouts;
     QList<CentralLayout *> m_centralLayouts;
+    //! most recently used layouts are at the end
+    QList<CentralLayout *> m_standbyLayouts;
+    //! layout files modification times when their layouts moved to standby
+    QHash<CentralLayout *, QDateTime> m_standbySyncTimes;
     AssignedLayoutsHash m_assignedLayouts;
 
     Layouts::Manager *m_manager;
     KActivities::Controller *m_activitiesController;
+    Layouts::MetadataIndex *m_metadataIndex;
 };
 
 }
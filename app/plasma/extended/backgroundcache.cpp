@@ -23,11 +23,19 @@
 #include "../../tools/commontools.h"
 
 // Qt
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QDirIterator>
 #include <QFileInfo>
 #include <QImage>
+#include <QImageReader>
 #include <QList>
 #include <QRgb>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QtMath>
 
 // Plasma
@@ -38,6 +46,22 @@
 #include <KDirWatch>
 
 #define MAXHASHSIZE 300
+//! images are analyzed downscaled, the views are always snapped to edges
+//! so edges do not need the full image resolution
+#define MAXANALYSISLENGTH 1920
+//! 24px. at the original image size should be enough
+#define EDGETHICKNESS 24
+
+//! increase it when the hints cache format or the hints calculations change
+#define HINTSCACHEVERSION 1
+#define HINTSCACHEFILE "lattedock/wallpaperhints.cache"
+
+//! slideshow images that are searched for each slideshow
+#define MAXSLIDESHOWIMAGES 100
+//! slideshow images that are analyzed in advance for all slideshows, the rest of
+//! the hints cache is left for the images that views request
+#define MAXPREFETCHEDIMAGES (MAXHASHSIZE / 2)
+#define SLIDESHOWPLUGIN "org.kde.slideshow"
 
 #define PLASMACONFIG "plasma-org.kde.plasma.desktop-appletsrc"
 #define DEFAULTWALLPAPER "wallpapers/Next/contents/images/1920x1080.png"
@@ -45,6 +69,53 @@
 namespace Latte{
 namespace PlasmaExtended {
 
+class ImageCalculationsJob : public QRunnable
+{
+public:
+    ImageCalculationsJob(BackgroundCache *cache, const QString &imageFile)
+        : m_cache(cache),
+          m_imageFile(imageFile)
+    {
+    }
+
+    void run() override
+    {
+        //! the stamp is taken before the image is read, so changes during
+        //! the analysis are identified the next time the image is validated
+        QString stamp = BackgroundCache::imageFileStamp(m_imageFile);
+        EdgesHash hints = BackgroundCache::imageCalculations(m_imageFile);
+        emit m_cache->imageCalculationsFinished(m_imageFile, stamp, hints);
+    }
+
+private:
+    BackgroundCache *m_cache{nullptr};
+    QString m_imageFile;
+};
+
+class SlideshowImagesJob : public QRunnable
+{
+public:
+    SlideshowImagesJob(BackgroundCache *cache, const QString &activity, const QString &screen, const QStringList &paths)
+        : m_cache(cache),
+          m_activity(activity),
+          m_screen(screen),
+          m_paths(paths)
+    {
+    }
+
+    void run() override
+    {
+        QStringList images = BackgroundCache::slideshowImages(m_paths);
+        emit m_cache->slideshowImagesFound(m_activity, m_screen, m_paths, images);
+    }
+
+private:
+    BackgroundCache *m_cache{nullptr};
+    QString m_activity;
+    QString m_screen;
+    QStringList m_paths;
+};
+
 BackgroundCache::BackgroundCache(QObject *parent)
     : QObject(parent),
       m_initialized(false),
@@ -67,11 +138,37 @@ BackgroundCache::BackgroundCache(QObject *parent)
         m_pool = new ScreenPool(this);
     }
 
+    //! one image is analyzed at a time, they are cpu and memory hungry
+    m_calculationsPool.setMaxThreadCount(1);
+    //! slideshow folders are searched separately, so images requested from
+    //! views are not waiting behind large folders
+    m_slideshowsPool.setMaxThreadCount(1);
+
+    qRegisterMetaType<EdgesHash>("EdgesHash");
+    connect(this, &BackgroundCache::imageCalculationsFinished, this, &BackgroundCache::onImageCalculationsFinished, Qt::QueuedConnection);
+    connect(this, &BackgroundCache::slideshowImagesFound, this, &BackgroundCache::onSlideshowImagesFound, Qt::QueuedConnection);
+
+    //! calculated hints are written in batches
+    m_saveHintsCacheTimer.setInterval(5000);
+    m_saveHintsCacheTimer.setSingleShot(true);
+    connect(&m_saveHintsCacheTimer, &QTimer::timeout, this, &BackgroundCache::saveHintsCache);
+
+    loadHintsCache();
+
     reload();
 }
 
 BackgroundCache::~BackgroundCache()
 {   
+    m_slideshowsPool.clear();
+    m_slideshowsPool.waitForDone();
+    m_calculationsPool.clear();
+    m_calculationsPool.waitForDone();
+
+    if (m_saveHintsCacheTimer.isActive()) {
+        saveHintsCache();
+    }
+
     if (m_pool) {
         m_pool->deleteLater();
     }
@@ -134,6 +231,8 @@ void BackgroundCache::reload()
 
     //!activityId and screen names for which their background was updated
     QHash<QString, QList<QString>> updates;
+    //!activityId, screen names and their slideshow paths
+    QHash<QString, QHash<QString, QStringList>> slideshows;
 
     for (const auto &containmentId : plasmaConfigContainments.groupList()) {
         const auto containment = plasmaConfigContainments.group(containmentId);
@@ -145,15 +244,22 @@ void BackgroundCache::reload()
         //! the containment is not a plasma desktop
         if (activity.isEmpty() || !isDesktopContainment(containment)) continue;
 
-        const auto returnedBackground = backgroundFromConfig(containment, wallpaperPlugin);
+        QString background = localFile(backgroundFromConfig(containment, wallpaperPlugin));
 
-        QString background = returnedBackground;
+        QString screenName = m_pool->connector(lastScreen);
 
-        if (background.startsWith("file://")) {
-            background = returnedBackground.mid(7);
-        }
+        if (wallpaperPlugin == SLIDESHOWPLUGIN) {
+            auto slideshowConfig = containment.group("Wallpaper").group(wallpaperPlugin).group("General");
+            QStringList slidePaths;
 
-        QString screenName = m_pool->connector(lastScreen);
+            for (const auto &path : slideshowConfig.readEntry("SlidePaths", QStringList())) {
+                slidePaths << localFile(path);
+            }
+
+            if (!slidePaths.isEmpty()) {
+                slideshows[activity][screenName] = slidePaths;
+            }
+        }
 
         //! Take case of broadcasted backgrounds, when their plugin is changed they should be disabled
         if (pluginExistsFor(activity,screenName)
@@ -179,8 +285,18 @@ void BackgroundCache::reload()
         m_backgrounds[activity][screenName] = background;
     }
 
+    //! image files are checked only when they become backgrounds, so hints
+    //! are provided to views without accessing the disk
+    for (const auto &activity : updates.keys()) {
+        for (const auto &screen : updates[activity]) {
+            validateHints(m_backgrounds[activity][screen]);
+        }
+    }
+
     m_initialized = true;
 
+    updateSlideshows(slideshows);
+
     for (const auto &activity : updates.keys()) {
         for (const auto &screen : updates[activity]) {
             emit backgroundChanged(activity, screen);
@@ -202,7 +318,7 @@ bool BackgroundCache::busyFor(QString activity, QString screen, Plasma::Types::L
     QString assignedBackground = background(activity, screen);
 
     if (!assignedBackground.isEmpty()) {
-        return busyForFile(assignedBackground, location);
+        return busyForFile(assignedBackground, location, activity, screen);
     }
 
     return false;
@@ -213,36 +329,19 @@ float BackgroundCache::brightnessFor(QString activity, QString screen, Plasma::T
     QString assignedBackground = background(activity, screen);
 
     if (!assignedBackground.isEmpty()) {
-        return brightnessForFile(assignedBackground, location);
+        return brightnessForFile(assignedBackground, location, activity, screen);
     }
 
     return -1000;
 }
 
-float BackgroundCache::brightnessFromArea(QImage &image, int firstRow, int firstColumn, int endRow, int endColumn)
+float BackgroundCache::brightnessFromArea(const QImage &image, int firstRow, int firstColumn, int endRow, int endColumn)
 {
-    float areaBrightness = -1000;
-
-    if (image.format() != QImage::Format_Invalid) {
-        for (int row = firstRow; row < endRow; ++row) {
-            QRgb *line = (QRgb *)image.scanLine(row);
-
-            for (int col = firstColumn; col < endColumn ; ++col) {
-                QRgb pixelData = line[col];
-                float pixelBrightness = Latte::colorBrightness(pixelData);
-
-                areaBrightness = (areaBrightness == -1000) ? pixelBrightness : (areaBrightness + pixelBrightness);
-            }
-        }
-
-        float areaSize = (endRow - firstRow) * (endColumn - firstColumn);
-        areaBrightness = areaBrightness / areaSize;
-    }
-
-    return areaBrightness;
+    //! end row and column are not part of the area
+    return Latte::areaBrightness(image, QRect(firstColumn, firstRow, endColumn - firstColumn, endRow - firstRow));
 }
 
-bool BackgroundCache::areaIsBusy(float bright1, float bright2) const
+bool BackgroundCache::areaIsBusy(float bright1, float bright2)
 {
     bool bright1IsLight = bright1>=123;
     bool bright2IsLight = bright2>=123;
@@ -261,131 +360,335 @@ bool BackgroundCache::areaIsBusy(float bright1, float bright2) const
 //! area brightness. In order to indicate if this area is busy or not we
 //! compare the minimum and the maximum values of brightness from these
 //! tiles. If the difference it too big then the area is busy
-void BackgroundCache::updateImageCalculations(QString imageFile, Plasma::Types::Location location)
+imageHints BackgroundCache::edgeCalculations(const QImage &image, Plasma::Types::Location location, int thickness)
 {
-    if (m_hintsCache.size() > MAXHASHSIZE) {
-        cleanupHashes();
-    }
+    float brightness{-1000};
+    float maxBrightness{0};
+    float minBrightness{255};
 
-    //! if it is a local image
-    QImage image(imageFile);
+    bool vertical = (location == Plasma::Types::LeftEdge || location == Plasma::Types::RightEdge) ? true : false;
+    int imageLength = !vertical ? image.width() : image.height();
+    int tiles{qMin(10,imageLength)};
 
-    if (image.format() != QImage::Format_Invalid) {
-        float brightness{-1000};
-        float maxBrightness{0};
-        float minBrightness{255};
+    int tileThickness = !vertical ? qMin(thickness,image.height()) : qMin(thickness,image.width());
 
-        bool vertical = (location == Plasma::Types::LeftEdge || location == Plasma::Types::RightEdge) ? true : false;
-        int imageLength = !vertical ? image.width() : image.height();
-        int tiles{qMin(10,imageLength)};
+    float factor = ((float)100/tiles)/100;
 
-        //! 24px. should be enough because the views are always snapped to edges
-        int tileThickness = !vertical ? qMin(24,image.height()) : qMin(24,image.width());
-        int tileLength = imageLength / tiles ;
+    QList<float> subBrightness;
 
-        int tileWidth = !vertical ? tileLength : tileThickness;
-        int tileHeight = !vertical ? tileThickness : tileLength;
+    //! Iterating algorigthm
+    int firstRow = 0; int firstColumn = 0; int endRow = 0; int endColumn = 0;
 
-        float factor = ((float)100/tiles)/100;
+    //! horizontal tiles calculations
+    if (location == Plasma::Types::TopEdge) {
+        firstRow = 0; endRow = tileThickness;
+    } else if (location == Plasma::Types::BottomEdge) {
+        firstRow = image.height() - tileThickness - 1; endRow = image.height() - 1;
+    }
 
-        QList<float> subBrightness;
+    if (!vertical) {
+        for (int i=1; i<=tiles; ++i) {
+            float subFactor = ((float)i) * factor;
+            firstColumn = endColumn+1; endColumn = (subFactor*imageLength) - 1;
+            endColumn = qMin(endColumn, imageLength-1);
 
-        qDebug() << "------------   -- Image Calculations --  --------------" ;
-        qDebug() << "Hints for Background image | " << imageFile;
-        qDebug() << "Hints for Background image | Edge: " << location << ", Image size: " << image.width() << "x" << image.height() << ", Tiles: " << tiles << ", subsize: " << tileWidth << "x" << tileHeight;
+            int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
 
-        //! Iterating algorigthm
-        int firstRow = 0; int firstColumn = 0; int endRow = 0; int endColumn = 0;
+            subBrightness.append(tempBrightness);
 
-        //! horizontal tiles calculations
-        if (location == Plasma::Types::TopEdge) {
-            firstRow = 0; endRow = tileThickness;
-        } else if (location == Plasma::Types::BottomEdge) {
-            firstRow = image.height() - tileThickness - 1; endRow = image.height() - 1;
+            if (tempBrightness > maxBrightness) {
+                maxBrightness = tempBrightness;
+            }
+            if (tempBrightness < minBrightness) {
+                minBrightness = tempBrightness;
+            }
         }
+    }
 
-        if (!vertical) {
-            for (int i=1; i<=tiles; ++i) {
-                float subFactor = ((float)i) * factor;
-                firstColumn = endColumn+1; endColumn = (subFactor*imageLength) - 1;
-                endColumn = qMin(endColumn, imageLength-1);
+    //! vertical tiles calculations
+    if (location == Plasma::Types::LeftEdge) {
+        firstColumn = 0; endColumn = tileThickness;
+    } else if (location == Plasma::Types::RightEdge) {
+        firstColumn = image.width() - 1 - tileThickness; endColumn = image.width() - 1;
+    }
 
-                int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
-                qDebug() << " Tile considering horizontal << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
-                         << ", brightness: " << tempBrightness;
+    if (vertical) {
+        for (int i=1; i<=tiles; ++i) {
+            float subFactor = ((float)i) * factor;
+            firstRow = endRow+1; endRow = (subFactor*imageLength) - 1;
+            endRow = qMin(endRow, imageLength-1);
 
-                subBrightness.append(tempBrightness);
+            int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
 
-                if (tempBrightness > maxBrightness) {
-                    maxBrightness = tempBrightness;
-                }
-                if (tempBrightness < minBrightness) {
-                    minBrightness = tempBrightness;
-                }
+            subBrightness.append(tempBrightness);
+
+            if (tempBrightness > maxBrightness) {
+                maxBrightness = tempBrightness;
+            }
+            if (tempBrightness < minBrightness) {
+                minBrightness = tempBrightness;
             }
         }
+    }
+
+    //! compute total brightness for this area
+    float subBrightnessSum = 0;
+
+    for (int i=0; i<subBrightness.count(); ++i) {
+        subBrightnessSum = subBrightnessSum + subBrightness[i];
+    }
+
+    brightness = subBrightnessSum / subBrightness.count();
+
+    imageHints iHints;
+    iHints.brightness = brightness;
+    iHints.minBrightness = minBrightness;
+    iHints.maxBrightness = maxBrightness;
+    iHints.busy = areaIsBusy(minBrightness, maxBrightness);
+
+    qDebug() << "Hints for Background image | Edge: " << location << ", Brightness: " << iHints.brightness << ", Busy: " << iHints.busy
+             << ", minBright:" << minBrightness << ", maxBright:" << maxBrightness;
+
+    return iHints;
+}
+
+EdgesHash BackgroundCache::imageCalculations(const QString &imageFile)
+{
+    EdgesHash hints;
+
+    //! only a downscaled version of the image is decoded, for many formats e.g. jpeg
+    //! the decoder itself is scaling and the full image is never created
+    QImageReader reader(imageFile);
+    QSize imageSize = reader.size();
+    qreal scale{1.0};
+
+    if (imageSize.isValid() && qMax(imageSize.width(), imageSize.height()) > MAXANALYSISLENGTH) {
+        scale = (qreal)MAXANALYSISLENGTH / qMax(imageSize.width(), imageSize.height());
+        reader.setScaledSize(imageSize * scale);
+    }
+
+    QImage image = reader.read();
+
+    if (image.isNull()) {
+        return hints;
+    }
 
-        //! vertical tiles calculations
-        if (location == Plasma::Types::LeftEdge) {
-            firstColumn = 0; endColumn = tileThickness;
-        } else if (location == Plasma::Types::RightEdge) {
-            firstColumn = image.width() - 1 - tileThickness; endColumn = image.width() - 1;
+    //! scanlines are read as 32bit pixels
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32) {
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    int thickness = qMax(2, qRound(EDGETHICKNESS * scale));
+
+    qDebug() << "------------   -- Image Calculations --  --------------" ;
+    qDebug() << "Hints for Background image | " << imageFile;
+    qDebug() << "Hints for Background image | Image size: " << imageSize << ", Analyzed size: " << image.size();
+
+    //! all edges are calculated at once in order to decode the image only once
+    const QList<Plasma::Types::Location> edges{Plasma::Types::TopEdge, Plasma::Types::BottomEdge, Plasma::Types::LeftEdge, Plasma::Types::RightEdge};
+
+    for (const auto edge : edges) {
+        hints[edge] = edgeCalculations(image, edge, thickness);
+    }
+
+    return hints;
+}
+
+void BackgroundCache::requestImageCalculations(QString imageFile, QString activity, QString screen)
+{
+    QPair<QString, QString> requester(activity, screen);
+
+    if (m_pendingCalculations.contains(imageFile)) {
+        if (!m_pendingCalculations[imageFile].contains(requester)) {
+            m_pendingCalculations[imageFile].append(requester);
         }
 
-        if (vertical) {
-            for (int i=1; i<=tiles; ++i) {
-                float subFactor = ((float)i) * factor;
-                firstRow = endRow+1; endRow = (subFactor*imageLength) - 1;
-                endRow = qMin(endRow, imageLength-1);
+        return;
+    }
 
-                int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
-                qDebug() << " Tile considering vertical << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
-                         << ", brightness: " << tempBrightness;
+    m_pendingCalculations[imageFile].append(requester);
+    m_calculationsPool.start(new ImageCalculationsJob(this, imageFile));
+}
 
-                subBrightness.append(tempBrightness);
+QString BackgroundCache::imageFileStamp(const QString &imageFile)
+{
+    QFileInfo info(imageFile);
 
-                if (tempBrightness > maxBrightness) {
-                    maxBrightness = tempBrightness;
-                }
-                if (tempBrightness < minBrightness) {
-                    minBrightness = tempBrightness;
-                }
+    if (!info.exists()) {
+        return QString();
+    }
+
+    return QString::number(info.size()) + QLatin1Char(':') + QString::number(info.lastModified().toMSecsSinceEpoch());
+}
+
+void BackgroundCache::onImageCalculationsFinished(const QString &imageFile, const QString &stamp, const EdgesHash &hints)
+{
+    //! invalid images are also stored in order to not be analyzed again
+    m_hintsCache[imageFile] = hints;
+    m_hintsStamps[imageFile] = stamp;
+    touchHints(imageFile);
+
+    cleanupHashes();
+    m_saveHintsCacheTimer.start();
+
+    const QList<QPair<QString, QString>> requesters = m_pendingCalculations.take(imageFile);
+
+    for (const auto &requester : requesters) {
+        emit backgroundChanged(requester.first, requester.second);
+    }
+
+    if (imageFile == m_prefetchingImage) {
+        m_prefetchingImage.clear();
+        prefetchNextImage();
+    }
+}
+
+QString BackgroundCache::localFile(const QString &file)
+{
+    if (file.startsWith("file://")) {
+        return file.mid(7);
+    }
+
+    return file;
+}
+
+QStringList BackgroundCache::slideshowImages(const QStringList &paths)
+{
+    QStringList images;
+    QStringList nameFilters;
+
+    for (const auto &format : QImageReader::supportedImageFormats()) {
+        nameFilters << QStringLiteral("*.") + QString::fromLatin1(format);
+    }
+
+    for (const auto &path : paths) {
+        QDirIterator it(path, nameFilters, QDir::Files | QDir::Readable, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+
+        while (it.hasNext() && images.count() < MAXSLIDESHOWIMAGES) {
+            QString image = it.next();
+
+            if (!images.contains(image)) {
+                images << image;
             }
         }
-        //! compute total brightness for this area
-        float subBrightnessSum = 0;
+    }
 
-        for (int i=0; i<subBrightness.count(); ++i) {
-            subBrightnessSum = subBrightnessSum + subBrightness[i];
+    return images;
+}
+
+void BackgroundCache::updateSlideshows(const QHash<QString, QHash<QString, QStringList>> &slideshows)
+{
+    bool changed{false};
+
+    //! slideshows that are not used any more
+    for (const auto &activity : m_slideshowPaths.keys()) {
+        for (const auto &screen : m_slideshowPaths[activity].keys()) {
+            if (!slideshows.contains(activity) || !slideshows[activity].contains(screen)) {
+                m_slideshowPaths[activity].remove(screen);
+                m_slideshowImages[activity].remove(screen);
+                changed = true;
+            }
         }
 
-        brightness = subBrightnessSum / subBrightness.count();
+        if (m_slideshowPaths[activity].isEmpty()) {
+            m_slideshowPaths.remove(activity);
+            m_slideshowImages.remove(activity);
+        }
+    }
 
-        bool areaBusy = areaIsBusy(minBrightness, maxBrightness);
+    //! new or changed slideshows, their images are searched in a worker thread
+    for (const auto &activity : slideshows.keys()) {
+        for (const auto &screen : slideshows[activity].keys()) {
+            const QStringList &paths = slideshows[activity][screen];
 
-        qDebug() << "Hints for Background image | Brightness: " << brightness << ", Busy: " << areaBusy << ", minBright:" << minBrightness << ", maxBright:" << maxBrightness;
+            if (m_slideshowPaths.value(activity).value(screen) != paths) {
+                m_slideshowPaths[activity][screen] = paths;
+                m_slideshowImages[activity].remove(screen);
+                changed = true;
 
-        if (!m_hintsCache.keys().contains(imageFile)) {
-            m_hintsCache[imageFile] = EdgesHash();
+                m_slideshowsPool.start(new SlideshowImagesJob(this, activity, screen, paths));
+            }
         }
+    }
 
-        if (!m_hintsCache[imageFile].contains(location)) {
-            imageHints iHints;
-            iHints.brightness = brightness; iHints.busy = areaBusy;
-            m_hintsCache[imageFile].insert(location, iHints);
-        } else {
-            m_hintsCache[imageFile][location].brightness = brightness;
-            m_hintsCache[imageFile][location].busy = areaBusy;
+    if (changed) {
+        updatePrefetchQueue();
+    }
+}
+
+void BackgroundCache::onSlideshowImagesFound(const QString &activity, const QString &screen, const QStringList &paths, const QStringList &images)
+{
+    //! slideshow changed in the meantime
+    if (m_slideshowPaths.value(activity).value(screen) != paths) {
+        return;
+    }
+
+    m_slideshowImages[activity][screen] = images;
+    updatePrefetchQueue();
+}
+
+void BackgroundCache::updatePrefetchQueue()
+{
+    m_prefetchQueue.clear();
+
+    int slideshows{0};
+
+    for (const auto &screens : m_slideshowImages) {
+        slideshows += screens.count();
+    }
+
+    if (slideshows == 0) {
+        return;
+    }
+
+    //! slideshows share the prefetch budget, so their images do not evict each other
+    int maxImages = qMax(1, MAXPREFETCHEDIMAGES / slideshows);
+
+    for (const auto &screens : m_slideshowImages) {
+        for (const auto &images : screens) {
+            for (int i=0; i<qMin(images.count(), maxImages); ++i) {
+                const QString &image = images[i];
+
+                if (!m_hintsCache.contains(image) && !m_prefetchQueue.contains(image)) {
+                    m_prefetchQueue << image;
+                }
+            }
+        }
+    }
+
+    prefetchNextImage();
+}
+
+void BackgroundCache::prefetchNextImage()
+{
+    //! only one image is prefetched at a time, so images requested from views
+    //! are not waiting behind the whole slideshow
+    if (!m_prefetchingImage.isEmpty()) {
+        return;
+    }
+
+    while (!m_prefetchQueue.isEmpty()) {
+        QString image = m_prefetchQueue.takeFirst();
+
+        if (m_hintsCache.contains(image) || m_pendingCalculations.contains(image)) {
+            continue;
         }
+
+        m_prefetchingImage = image;
+        m_pendingCalculations[image] = QList<QPair<QString, QString>>();
+        m_calculationsPool.start(new ImageCalculationsJob(this, image));
+        return;
     }
 }
 
-float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Location location)
+float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Location location, QString activity, QString screen)
 {
-    if (m_hintsCache.keys().contains(imageFile)) {
-        if (m_hintsCache[imageFile].keys().contains(location)) {
+    if (hasValidHints(imageFile)) {
+        if (m_hintsCache[imageFile].contains(location)) {
             return m_hintsCache[imageFile][location].brightness;
         }
+
+        return -1000;
     }
 
     //! if it is a color
@@ -393,21 +696,19 @@ float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Locat
         return Latte::colorBrightness(QColor(imageFile));
     }
 
-    updateImageCalculations(imageFile, location);
-
-    if (m_hintsCache.keys().contains(imageFile)) {
-        return m_hintsCache[imageFile][location].brightness;
-    }
+    requestImageCalculations(imageFile, activity, screen);
 
     return -1000;
 }
 
-bool BackgroundCache::busyForFile(QString imageFile, Plasma::Types::Location location)
+bool BackgroundCache::busyForFile(QString imageFile, Plasma::Types::Location location, QString activity, QString screen)
 {
-    if (m_hintsCache.keys().contains(imageFile)) {
-        if (m_hintsCache[imageFile].keys().contains(location)) {
+    if (hasValidHints(imageFile)) {
+        if (m_hintsCache[imageFile].contains(location)) {
             return m_hintsCache[imageFile][location].busy;
         }
+
+        return false;
     }
 
     //! if it is a color
@@ -415,27 +716,138 @@ bool BackgroundCache::busyForFile(QString imageFile, Plasma::Types::Location loc
         return false;
     }
 
-    updateImageCalculations(imageFile, location);
+    requestImageCalculations(imageFile, activity, screen);
+
+    return false;
+}
+
+bool BackgroundCache::hasValidHints(const QString &imageFile)
+{
+    if (!m_hintsCache.contains(imageFile)) {
+        return false;
+    }
+
+    touchHints(imageFile);
+    return true;
+}
+
+void BackgroundCache::validateHints(const QString &imageFile)
+{
+    if (!m_hintsCache.contains(imageFile)) {
+        return;
+    }
 
-    if (m_hintsCache.keys().contains(imageFile)) {
-        return m_hintsCache[imageFile][location].busy;
+    //! the image changed on disk after its hints were calculated
+    if (m_hintsStamps.value(imageFile) != imageFileStamp(imageFile)) {
+        m_hintsCache.remove(imageFile);
+        m_hintsStamps.remove(imageFile);
+        m_hintsUsage.remove(imageFile);
+        m_saveHintsCacheTimer.start();
     }
+}
 
-    return false;
+void BackgroundCache::touchHints(const QString &imageFile)
+{
+    m_hintsUsage.touch(imageFile);
 }
 
 void BackgroundCache::cleanupHashes()
 {
-    if (m_hintsCache.count() <= MAXHASHSIZE) {
+    //! least recently used images are removed first
+    while (m_hintsCache.count() > MAXHASHSIZE && !m_hintsUsage.isEmpty()) {
+        QString imageFile = m_hintsUsage.takeLeastRecent();
+        m_hintsCache.remove(imageFile);
+        m_hintsStamps.remove(imageFile);
+    }
+}
+
+QString BackgroundCache::hintsCacheFilePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + QStringLiteral(HINTSCACHEFILE);
+}
+
+void BackgroundCache::loadHintsCache()
+{
+    QFile file(hintsCacheFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    qint32 version{0};
+    qint32 count{0};
+    in >> version >> count;
+
+    if (version != HINTSCACHEVERSION) {
         return;
     }
 
-    m_hintsCache.clear();
+    //! images are stored from least to most recently used
+    for (int i=0; i<count && in.status() == QDataStream::Ok; ++i) {
+        QString imageFile;
+        QString stamp;
+        qint32 edgesCount{0};
+
+        in >> imageFile >> stamp >> edgesCount;
+
+        EdgesHash hints;
+
+        for (int j=0; j<edgesCount; ++j) {
+            qint32 location;
+            imageHints iHints;
+            in >> location >> iHints.busy >> iHints.brightness >> iHints.minBrightness >> iHints.maxBrightness;
+            hints[static_cast<Plasma::Types::Location>(location)] = iHints;
+        }
+
+        //! images that changed since their hints were calculated are ignored
+        if (in.status() != QDataStream::Ok || stamp.isEmpty() || stamp != imageFileStamp(imageFile)) {
+            continue;
+        }
+
+        m_hintsCache[imageFile] = hints;
+        m_hintsStamps[imageFile] = stamp;
+        touchHints(imageFile);
+    }
+
+    cleanupHashes();
+}
+
+void BackgroundCache::saveHintsCache()
+{
+    QString filePath = hintsCacheFilePath();
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+
+    out << (qint32)HINTSCACHEVERSION << (qint32)m_hintsUsage.count();
+
+    for (const auto &imageFile : m_hintsUsage.keys()) {
+        const EdgesHash &hints = m_hintsCache[imageFile];
+
+        out << imageFile << m_hintsStamps.value(imageFile) << (qint32)hints.count();
+
+        for (auto it = hints.constBegin(); it != hints.constEnd(); ++it) {
+            out << (qint32)it.key() << it.value().busy << it.value().brightness << it.value().minBrightness << it.value().maxBrightness;
+        }
+    }
+
+    file.commit();
 }
 
 void BackgroundCache::setBackgroundFromBroadcast(QString activity, QString screen, QString filename)
 {
     if (QFileInfo(filename).exists()) {
+        validateHints(filename);
         setBroadcastedBackgroundsEnabled(activity, screen, true);
         m_backgrounds[activity][screen] = filename;
         emit backgroundChanged(activity, screen);
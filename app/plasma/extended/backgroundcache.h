@@ -22,10 +22,16 @@
 
 // local
 #include "screenpool.h"
+#include "../../tools/recentlyused.h"
 
 // Qt
 #include <QHash>
+#include <QImage>
 #include <QObject>
+#include <QPair>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
 
 // Plasma
 #include <Plasma>
@@ -37,6 +43,8 @@
 struct imageHints {
     bool busy{false};
     float brightness{-1000};
+    float minBrightness{-1000};
+    float maxBrightness{-1000};
 };
 
 typedef QHash<Plasma::Types::Location, imageHints> EdgesHash;
@@ -63,25 +71,59 @@ public:
 signals:
     void backgroundChanged(const QString &activity, const QString &screenName);
 
+    //! emitted from worker threads when an image analysis has finished
+    void imageCalculationsFinished(const QString &imageFile, const QString &stamp, const EdgesHash &hints);
+    //! emitted from worker threads when the images of slideshow paths have been found
+    void slideshowImagesFound(const QString &activity, const QString &screen, const QStringList &paths, const QStringList &images);
+
 private slots:
     void reload();
     void settingsFileChanged(const QString &file);
+    void onImageCalculationsFinished(const QString &imageFile, const QString &stamp, const EdgesHash &hints);
+    void onSlideshowImagesFound(const QString &activity, const QString &screen, const QStringList &paths, const QStringList &images);
+    void saveHintsCache();
 
 private:
     BackgroundCache(QObject *parent = nullptr);
 
     bool backgroundIsBroadcasted(QString activity, QString screenName) const;
     bool pluginExistsFor(QString activity, QString screenName) const;
-    bool areaIsBusy(float bright1, float bright2) const;
-    bool busyForFile(QString imageFile, Plasma::Types::Location location);
+    bool busyForFile(QString imageFile, Plasma::Types::Location location, QString activity, QString screen);
     bool isDesktopContainment(const KConfigGroup &containment) const;
 
-    float brightnessForFile(QString imageFile, Plasma::Types::Location location);
-    float brightnessFromArea(QImage &image, int firstRow, int firstColumn, int endRow, int endColumn);
+    float brightnessForFile(QString imageFile, Plasma::Types::Location location, QString activity, QString screen);
     QString backgroundFromConfig(const KConfigGroup &config, QString wallpaperPlugin) const;
 
     void cleanupHashes();
-    void updateImageCalculations(QString imageFile, Plasma::Types::Location location);
+    void loadHintsCache();
+    //! hints are served from memory, they are validated against the image
+    //! file only when they are loaded or the image becomes a background
+    bool hasValidHints(const QString &imageFile);
+    //! drops the image hints when the image changed since they were calculated
+    void validateHints(const QString &imageFile);
+    //! recently used images are evicted last
+    void touchHints(const QString &imageFile);
+
+    QString hintsCacheFilePath() const;
+    //! image analysis happens in a worker thread and activity/screen are informed
+    //! through backgroundChanged when the results are available
+    void requestImageCalculations(QString imageFile, QString activity, QString screen);
+
+    //! slideshow images are analyzed in advance one at a time, so when the slideshow
+    //! advances and the new image is broadcasted its hints are already available
+    void updateSlideshows(const QHash<QString, QHash<QString, QStringList>> &slideshows);
+    void updatePrefetchQueue();
+    void prefetchNextImage();
+
+    //! Image calculations, they are used from worker threads
+    static bool areaIsBusy(float bright1, float bright2);
+    static float brightnessFromArea(const QImage &image, int firstRow, int firstColumn, int endRow, int endColumn);
+    static imageHints edgeCalculations(const QImage &image, Plasma::Types::Location location, int thickness);
+    static EdgesHash imageCalculations(const QString &imageFile);
+    //! identifies the image file contents, it is based on file size and modification time
+    static QString imageFileStamp(const QString &imageFile);
+    static QString localFile(const QString &file);
+    static QStringList slideshowImages(const QStringList &paths);
 
 private:
     bool m_initialized{false};
@@ -100,8 +142,28 @@ private:
     //! and have higher priority: activity id, screen names
     QHash<QString, QList<QString>> m_broadcasted;
 
-    //! image file and brightness per edge
+    //! image file and brightness per edge, it is also stored on disk
     QHash<QString, EdgesHash> m_hintsCache;
+    //! image file and its stamp when its hints were calculated
+    QHash<QString, QString> m_hintsStamps;
+    //! image files from least to most recently used
+    RecentlyUsed<QString> m_hintsUsage;
+    QTimer m_saveHintsCacheTimer;
+
+    //! image files that are analyzed and the activity/screen pairs that requested them
+    QHash<QString, QList<QPair<QString, QString>>> m_pendingCalculations;
+    QThreadPool m_calculationsPool;
+
+    //! slideshow wallpapers: activity id, screen name, slideshow paths/images
+    QHash<QString, QHash<QString, QStringList>> m_slideshowPaths;
+    QHash<QString, QHash<QString, QStringList>> m_slideshowImages;
+    //! slideshow images whose hints are not calculated yet
+    QStringList m_prefetchQueue;
+    QString m_prefetchingImage;
+    QThreadPool m_slideshowsPool;
+
+    friend class ImageCalculationsJob;
+    friend class SlideshowImagesJob;
 
     KSharedConfig::Ptr m_plasmaConfig;
 };
@@ -95,6 +95,39 @@ QColor PanelBackground::shadowColor() const
     return m_shadowColor;
 }
 
+BackgroundMetrics PanelBackground::metrics() const
+{
+    BackgroundMetrics metrics;
+    metrics.paddingTop = m_paddingTop;
+    metrics.paddingLeft = m_paddingLeft;
+    metrics.paddingBottom = m_paddingBottom;
+    metrics.paddingRight = m_paddingRight;
+    metrics.shadowSize = m_shadowSize;
+    metrics.roundness = m_roundness;
+    metrics.maxOpacity = m_maxOpacity;
+    metrics.shadowColor = m_shadowColor;
+
+    return metrics;
+}
+
+void PanelBackground::setMetrics(const BackgroundMetrics &metrics)
+{
+    m_paddingTop = metrics.paddingTop;
+    m_paddingLeft = metrics.paddingLeft;
+    m_paddingBottom = metrics.paddingBottom;
+    m_paddingRight = metrics.paddingRight;
+    m_shadowSize = metrics.shadowSize;
+    m_roundness = metrics.roundness;
+    m_maxOpacity = metrics.maxOpacity;
+    m_shadowColor = metrics.shadowColor;
+
+    emit maxOpacityChanged();
+    emit paddingsChanged();
+    emit roundnessChanged();
+    emit shadowSizeChanged();
+    emit shadowColorChanged();
+}
+
 QString PanelBackground::prefixed(const QString &id)
 {
     if (m_location == Plasma::Types::TopEdge) {
@@ -22,6 +22,7 @@
 #define PLASMATHEMEEXTENDEDPANELBACKGROUND_H
 
 // Qt
+#include <QColor>
 #include <QObject>
 
 // Plasma
@@ -37,6 +38,18 @@ class Theme;
 namespace Latte {
 namespace PlasmaExtended {
 
+//! panel background values that are discovered from the plasma theme svgs
+struct BackgroundMetrics {
+    int paddingTop{0};
+    int paddingLeft{0};
+    int paddingBottom{0};
+    int paddingRight{0};
+    int shadowSize{0};
+    int roundness{0};
+    float maxOpacity{1.0};
+    QColor shadowColor;
+};
+
 class PanelBackground: public QObject
 {
     Q_OBJECT
@@ -68,6 +81,10 @@ public:
 
     QColor shadowColor() const;
 
+    BackgroundMetrics metrics() const;
+    //! apply previously discovered values without analyzing the theme svgs
+    void setMetrics(const BackgroundMetrics &metrics);
+
 public slots:
     void update();
 
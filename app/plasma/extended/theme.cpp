@@ -29,10 +29,15 @@
 #include "../../tools/commontools.h"
 
 // Qt
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QFileInfo>
 #include <QPainter>
 #include <QProcess>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 // KDE
 #include <KDirWatch>
@@ -45,6 +50,12 @@
 #define DEFAULTCOLORSCHEME "default.colors"
 #define REVERSEDCOLORSCHEME "reversed.colors"
 
+//! increase it when the analysis cache format or the theme analysis change
+#define ANALYSISCACHEVERSION 1
+#define ANALYSISCACHEFILE "lattedock/plasmathemeanalysis.cache"
+//! analyses of older themes that are kept
+#define MAXCACHEDANALYSES 10
+
 namespace Latte {
 namespace PlasmaExtended {
 
@@ -79,6 +90,7 @@ Theme::Theme(KSharedConfig::Ptr config, QObject *parent) :
     //!
 
     loadConfig();
+    loadAnalysisCache();
 
     connect(this, &Theme::compositingChanged, this, &Theme::updateBackgrounds);
     connect(this, &Theme::outlineWidthChanged, this, &Theme::saveConfig);
@@ -310,12 +322,140 @@ void Theme::updateReversedSchemeValues()
 
 void Theme::updateBackgrounds()
 {
-    updateHasShadow();
+    const QString key = analysisKey();
+    bool analysisChanged{false};
+
+    if (!m_analysisCache.contains(key) && m_analysisCache.count() >= MAXCACHEDANALYSES) {
+        m_analysisCache.clear();
+    }
+
+    ThemeAnalysis &analysis = m_analysisCache[key];
+
+    if (analysis.hasShadowAnalyzed) {
+        m_hasShadow = analysis.hasShadow;
+        emit hasShadowChanged();
+    } else {
+        updateHasShadow();
+        analysis.hasShadowAnalyzed = true;
+        analysis.hasShadow = m_hasShadow;
+        analysisChanged = true;
+    }
+
+    //! only the edges that have not been analyzed yet are calculated
+    const QList<PanelBackground *> backgrounds{m_backgroundTopEdge, m_backgroundLeftEdge, m_backgroundBottomEdge, m_backgroundRightEdge};
+    const QList<Plasma::Types::Location> edges{Plasma::Types::TopEdge, Plasma::Types::LeftEdge, Plasma::Types::BottomEdge, Plasma::Types::RightEdge};
+
+    for (int i=0; i<backgrounds.count(); ++i) {
+        if (analysis.backgrounds.contains(edges[i])) {
+            backgrounds[i]->setMetrics(analysis.backgrounds[edges[i]]);
+        } else {
+            backgrounds[i]->update();
+            analysis.backgrounds[edges[i]] = backgrounds[i]->metrics();
+            analysisChanged = true;
+        }
+    }
+
+    if (analysisChanged) {
+        saveAnalysisCache();
+    }
+}
+
+QString Theme::analysisKey() const
+{
+    QStringList key{m_theme.themeName(), m_compositing ? QStringLiteral("compositing") : QStringLiteral("nocompositing")};
+
+    //! svgs colors depend on the color scheme
+    const QStringList files{m_theme.imagePath(QStringLiteral("widgets/panel-background")),
+                m_theme.imagePath(QStringLiteral("opaque/widgets/panel-background")),
+                m_originalSchemePath};
+
+    for (const auto &file : files) {
+        QFileInfo info(file);
+        key << file << (info.exists() ? QString::number(info.lastModified().toMSecsSinceEpoch()) : QString());
+    }
+
+    return key.join(QLatin1Char('|'));
+}
+
+QString Theme::analysisCacheFilePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + QStringLiteral(ANALYSISCACHEFILE);
+}
+
+void Theme::loadAnalysisCache()
+{
+    QFile file(analysisCacheFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    qint32 version{0};
+    qint32 count{0};
+    in >> version >> count;
+
+    if (version != ANALYSISCACHEVERSION) {
+        return;
+    }
+
+    for (int i=0; i<count && in.status() == QDataStream::Ok; ++i) {
+        QString key;
+        ThemeAnalysis analysis;
+        qint32 edgesCount{0};
+
+        in >> key >> analysis.hasShadowAnalyzed >> analysis.hasShadow >> edgesCount;
+
+        for (int j=0; j<edgesCount; ++j) {
+            qint32 edge{0};
+            BackgroundMetrics metrics;
+
+            in >> edge >> metrics.paddingTop >> metrics.paddingLeft >> metrics.paddingBottom >> metrics.paddingRight
+               >> metrics.shadowSize >> metrics.roundness >> metrics.maxOpacity >> metrics.shadowColor;
+
+            analysis.backgrounds[edge] = metrics;
+        }
+
+        if (in.status() != QDataStream::Ok) {
+            break;
+        }
+
+        m_analysisCache[key] = analysis;
+    }
+}
+
+void Theme::saveAnalysisCache()
+{
+    QString filePath = analysisCacheFilePath();
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+
+    out << (qint32)ANALYSISCACHEVERSION << (qint32)m_analysisCache.count();
+
+    for (auto it = m_analysisCache.constBegin(); it != m_analysisCache.constEnd(); ++it) {
+        const ThemeAnalysis &analysis = it.value();
+
+        out << it.key() << analysis.hasShadowAnalyzed << analysis.hasShadow << (qint32)analysis.backgrounds.count();
+
+        for (auto bit = analysis.backgrounds.constBegin(); bit != analysis.backgrounds.constEnd(); ++bit) {
+            const BackgroundMetrics &metrics = bit.value();
+
+            out << (qint32)bit.key() << metrics.paddingTop << metrics.paddingLeft << metrics.paddingBottom << metrics.paddingRight
+                << metrics.shadowSize << metrics.roundness << metrics.maxOpacity << metrics.shadowColor;
+        }
+    }
 
-    m_backgroundTopEdge->update();
-    m_backgroundLeftEdge->update();
-    m_backgroundBottomEdge->update();
-    m_backgroundRightEdge->update();
+    file.commit();
 }
 
 void Theme::updateHasShadow()
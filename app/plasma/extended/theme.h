@@ -21,6 +21,9 @@
 #ifndef PLASMATHEMEEXTENDED_H
 #define PLASMATHEMEEXTENDED_H
 
+// local
+#include "panelbackground.h"
+
 // C++
 #include <array>
 
@@ -60,6 +63,15 @@ struct CornerRegions {
     QRegion bottomRight;
 };
 
+//! plasma theme svgs analysis results, they are stored on disk in order
+//! to not rasterize and scan the theme svgs at every startup
+struct ThemeAnalysis {
+    bool hasShadowAnalyzed{false};
+    bool hasShadow{false};
+    //! edge, panel background values
+    QHash<int, BackgroundMetrics> backgrounds;
+};
+
 class Theme: public QObject
 {
     Q_OBJECT
@@ -119,6 +131,13 @@ private:
     void loadCompositingRoundness();
     void updateBackgrounds();
 
+    void loadAnalysisCache();
+    void saveAnalysisCache();
+    //! identifies the current theme analysis, it is based on theme name, compositing
+    //! and the modification times of the files that are used for the analysis
+    QString analysisKey() const;
+    QString analysisCacheFilePath() const;
+
     void setOriginalSchemeFile(const QString &file);
     void updateHasShadow();
     void updateDefaultScheme();
@@ -143,6 +162,9 @@ private:
 
     QHash<int, CornerRegions> m_cornerRegions;
 
+    //! analysis key, theme analysis
+    QHash<QString, ThemeAnalysis> m_analysisCache;
+
     std::array<QMetaObject::Connection, 2> m_kdeConnections;
 
     QTemporaryDir m_extendedThemeDir;
@@ -73,6 +73,17 @@ void TabPreferences::initUi()
         emit dataChanged();
     });
 
+    connect(m_ui->standbyLayoutsSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), [ = ](int i) {
+        m_preferences.standbyLayouts = m_ui->standbyLayoutsSpinBox->value();
+        m_ui->standbyMemorySpinBox->setEnabled(m_preferences.standbyLayouts > 0);
+        emit dataChanged();
+    });
+
+    connect(m_ui->standbyMemorySpinBox, QOverload<int>::of(&QSpinBox::valueChanged), [ = ](int i) {
+        m_preferences.standbyMemory = m_ui->standbyMemorySpinBox->value();
+        emit dataChanged();
+    });
+
     connect(m_ui->autostartChkBox, &QCheckBox::stateChanged, this, [&]() {
         m_preferences.autostart = m_ui->autostartChkBox->isChecked();
         emit dataChanged();
@@ -120,6 +131,8 @@ void TabPreferences::initSettings()
     o_preferences.mouseSensitivity = m_corona->universalSettings()->sensitivity();
     o_preferences.screensDelay = m_corona->universalSettings()->screenTrackerInterval();
     o_preferences.outlineWidth = m_corona->themeExtended()->outlineWidth();
+    o_preferences.standbyLayouts = m_corona->universalSettings()->standbyLayouts();
+    o_preferences.standbyMemory = m_corona->universalSettings()->standbyMemory();
 
     m_preferences = o_preferences;
 
@@ -137,6 +150,9 @@ void TabPreferences::updateUi()
     m_ui->noBordersForMaximizedChkBox->setChecked(m_preferences.borderlessMaximized);
     m_ui->screenTrackerSpinBox->setValue(m_preferences.screensDelay);
     m_ui->outlineSpinBox->setValue(m_preferences.outlineWidth);
+    m_ui->standbyLayoutsSpinBox->setValue(m_preferences.standbyLayouts);
+    m_ui->standbyMemorySpinBox->setValue(m_preferences.standbyMemory);
+    m_ui->standbyMemorySpinBox->setEnabled(m_preferences.standbyLayouts > 0);
 
     if (m_preferences.mouseSensitivity == Settings::LowMouseSensitivity) {
         m_ui->lowSensitivityBtn->setChecked(true);
@@ -181,6 +197,8 @@ void TabPreferences::save()
     m_corona->universalSettings()->setShowInfoWindow(m_preferences.layoutsInformationWindow);
     m_corona->universalSettings()->setCanDisableBorders(m_preferences.borderlessMaximized);
     m_corona->universalSettings()->setScreenTrackerInterval(m_preferences.screensDelay);
+    m_corona->universalSettings()->setStandbyLayouts(m_preferences.standbyLayouts);
+    m_corona->universalSettings()->setStandbyMemory(m_preferences.standbyMemory);
     m_corona->themeExtended()->setOutlineWidth(m_preferences.outlineWidth);
 
     o_preferences = m_preferences;
@@ -63,6 +63,8 @@ UniversalSettings::UniversalSettings(KSharedConfig::Ptr config, QObject *parent)
     connect(this, &UniversalSettings::screenTrackerIntervalChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::showInfoWindowChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::singleModeLayoutNameChanged, this, &UniversalSettings::saveConfig);
+    connect(this, &UniversalSettings::standbyLayoutsChanged, this, &UniversalSettings::saveConfig);
+    connect(this, &UniversalSettings::standbyMemoryChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::versionChanged, this, &UniversalSettings::saveConfig);
 
     connect(this, &UniversalSettings::screenScalesChanged, this, &UniversalSettings::saveScalesConfig);
@@ -179,6 +181,40 @@ void UniversalSettings::setScreenTrackerInterval(int duration)
     emit screenTrackerIntervalChanged();
 }
 
+int UniversalSettings::standbyLayouts() const
+{
+    return m_standbyLayouts;
+}
+
+void UniversalSettings::setStandbyLayouts(int count)
+{
+    count = qMax(0, count);
+
+    if (m_standbyLayouts == count) {
+        return;
+    }
+
+    m_standbyLayouts = count;
+    emit standbyLayoutsChanged();
+}
+
+int UniversalSettings::standbyMemory() const
+{
+    return m_standbyMemory;
+}
+
+void UniversalSettings::setStandbyMemory(int megabytes)
+{
+    megabytes = qMax(0, megabytes);
+
+    if (m_standbyMemory == megabytes) {
+        return;
+    }
+
+    m_standbyMemory = megabytes;
+    emit standbyMemoryChanged();
+}
+
 QString UniversalSettings::singleModeLayoutName() const
 {
     return m_singleModeLayoutName;
@@ -521,6 +557,8 @@ void UniversalSettings::loadConfig()
     m_screenTrackerInterval = m_universalGroup.readEntry("screenTrackerInterval", 2500);
     m_showInfoWindow = m_universalGroup.readEntry("showInfoWindow", true);
     m_singleModeLayoutName = m_universalGroup.readEntry("singleModeLayoutName", QString());
+    m_standbyLayouts = qMax(0, m_universalGroup.readEntry("standbyLayouts", 0));
+    m_standbyMemory = qMax(0, m_universalGroup.readEntry("standbyMemory", 64));
     m_memoryUsage = static_cast<MemoryUsage::LayoutsMemory>(m_universalGroup.readEntry("memoryUsage", (int)MemoryUsage::SingleLayout));
     m_sensitivity = static_cast<Settings::MouseSensitivity>(m_universalGroup.readEntry("mouseSensitivity", (int)Settings::HighMouseSensitivity));
 
@@ -542,6 +580,8 @@ void UniversalSettings::saveConfig()
     m_universalGroup.writeEntry("screenTrackerInterval", m_screenTrackerInterval);
     m_universalGroup.writeEntry("showInfoWindow", m_showInfoWindow);
     m_universalGroup.writeEntry("singleModeLayoutName", m_singleModeLayoutName);
+    m_universalGroup.writeEntry("standbyLayouts", m_standbyLayouts);
+    m_universalGroup.writeEntry("standbyMemory", m_standbyMemory);
     m_universalGroup.writeEntry("memoryUsage", (int)m_memoryUsage);
     m_universalGroup.writeEntry("mouseSensitivity", (int)m_sensitivity);
 }
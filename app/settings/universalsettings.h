@@ -106,6 +106,15 @@ public:
     int screenTrackerInterval() const;
     void setScreenTrackerInterval(int duration);
 
+    //! how many recently used layouts are kept loaded but hidden in MultipleLayouts mode,
+    //! zero disables warm standby
+    int standbyLayouts() const;
+    void setStandbyLayouts(int count);
+
+    //! memory in MB that the views of standby layouts are allowed to keep
+    int standbyMemory() const;
+    void setStandbyMemory(int megabytes);
+
     QString singleModeLayoutName() const;
     void setSingleModeLayoutName(QString layoutName);
 
@@ -148,6 +157,8 @@ signals:
     void screenTrackerIntervalChanged();
     void showInfoWindowChanged();
     void singleModeLayoutNameChanged();
+    void standbyLayoutsChanged();
+    void standbyMemoryChanged();
     void versionChanged();
 
 private slots:
@@ -185,6 +196,8 @@ private:
     int m_version{1};
 
     int m_screenTrackerInterval{2500};
+    int m_standbyLayouts{0};
+    int m_standbyMemory{64};
 
     QString m_singleModeLayoutName;
 
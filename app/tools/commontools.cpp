@@ -25,8 +25,298 @@
 #include <QStandardPaths>
 #include <QtMath>
 
+#if defined(__SSE2__) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#define LATTE_SSE2_KERNELS
+#include <emmintrin.h>
+#endif
+
+//! AVX2 kernels are compiled for their own target and they are used only
+//! when the running cpu supports them, so the binary stays SSE2 compatible
+#if defined(LATTE_SSE2_KERNELS) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LATTE_AVX2_KERNELS
+#define LATTE_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
 namespace Latte {
 
+namespace {
+//! colorBrightness() weights multiplied by 1000 in order to sum pixels with integers
+const int REDWEIGHT = 299;
+const int GREENWEIGHT = 587;
+const int BLUEWEIGHT = 114;
+
+//! pixels summed in 32bit lanes before they are flushed to the 64bit sum,
+//! it keeps the lanes from overflowing for very wide images
+const int MAXLANEPIXELS = 4096;
+
+//! 32bit pixels are read as they are stored, premultiplied ones included,
+//! the same way the per-pixel loops that these kernels replaced did
+QImage argb32Image(const QImage &image)
+{
+    if (image.format() == QImage::Format_ARGB32
+            || image.format() == QImage::Format_RGB32
+            || image.format() == QImage::Format_ARGB32_Premultiplied) {
+        return image;
+    }
+
+    return image.convertToFormat(QImage::Format_ARGB32);
+}
+
+//! weighted color channels used in order to identify an image dominant color
+struct WeightedSums
+{
+    float r{0};
+    float g{0};
+    float b{0};
+    float relevance{0};
+};
+
+bool s_avx2KernelsEnabled{true};
+
+bool hasAvx2()
+{
+#ifdef LATTE_AVX2_KERNELS
+    static const bool supported = []() {
+        __builtin_cpu_init();
+        return (bool)__builtin_cpu_supports("avx2");
+    }();
+
+    return s_avx2KernelsEnabled && supported;
+#else
+    return false;
+#endif
+}
+
+#ifdef LATTE_SSE2_KERNELS
+//! sums 4 pixels per step and returns the number of pixels that were summed
+int brightnessSumSse2(const QRgb *line, int count, quint64 &sum)
+{
+    //! in memory a 32bit pixel is stored as B,G,R,A
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights = _mm_setr_epi16(BLUEWEIGHT, GREENWEIGHT, REDWEIGHT, 0, BLUEWEIGHT, GREENWEIGHT, REDWEIGHT, 0);
+    const int vectorEnd = count - (count % 4);
+    int col{0};
+
+    while (col < vectorEnd) {
+        const int chunkEnd = qMin(vectorEnd, col + MAXLANEPIXELS);
+        __m128i lanes = _mm_setzero_si128();
+
+        for (; col < chunkEnd; col += 4) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + col));
+            lanes = _mm_add_epi32(lanes, _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights));
+            lanes = _mm_add_epi32(lanes, _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights));
+        }
+
+        qint32 lanesData[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanesData), lanes);
+        sum += (quint64)lanesData[0] + lanesData[1] + lanesData[2] + lanesData[3];
+    }
+
+    return col;
+}
+
+int weightedSumsSse2(const QRgb *line, int count, WeightedSums &sums)
+{
+    const __m128i channelMask = _mm_set1_epi32(0xff);
+    const __m128 inverted255 = _mm_set1_ps(1.0f / 255.0f);
+    const __m128 minRelevance = _mm_set1_ps(.1f);
+    const __m128 relevanceFactor = _mm_set1_ps(.9f);
+
+    __m128 rlanes = _mm_setzero_ps();
+    __m128 glanes = _mm_setzero_ps();
+    __m128 blanes = _mm_setzero_ps();
+    __m128 relevanceLanes = _mm_setzero_ps();
+
+    const int vectorEnd = count - (count % 4);
+    int col{0};
+
+    for (; col < vectorEnd; col += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + col));
+
+        const __m128 b = _mm_cvtepi32_ps(_mm_and_si128(pixels, channelMask));
+        const __m128 g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 8), channelMask));
+        const __m128 r = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 16), channelMask));
+        const __m128 a = _mm_cvtepi32_ps(_mm_srli_epi32(pixels, 24));
+
+        const __m128 maxChannel = _mm_max_ps(r, _mm_max_ps(g, b));
+        const __m128 minChannel = _mm_min_ps(r, _mm_min_ps(g, b));
+        const __m128 saturation = _mm_mul_ps(_mm_sub_ps(maxChannel, minChannel), inverted255);
+        const __m128 relevance = _mm_add_ps(minRelevance,
+                                            _mm_mul_ps(relevanceFactor, _mm_mul_ps(_mm_mul_ps(a, inverted255), saturation)));
+
+        rlanes = _mm_add_ps(rlanes, _mm_mul_ps(r, relevance));
+        glanes = _mm_add_ps(glanes, _mm_mul_ps(g, relevance));
+        blanes = _mm_add_ps(blanes, _mm_mul_ps(b, relevance));
+        relevanceLanes = _mm_add_ps(relevanceLanes, relevance);
+    }
+
+    float lanesData[4];
+
+    _mm_storeu_ps(lanesData, rlanes);
+    sums.r += lanesData[0] + lanesData[1] + lanesData[2] + lanesData[3];
+    _mm_storeu_ps(lanesData, glanes);
+    sums.g += lanesData[0] + lanesData[1] + lanesData[2] + lanesData[3];
+    _mm_storeu_ps(lanesData, blanes);
+    sums.b += lanesData[0] + lanesData[1] + lanesData[2] + lanesData[3];
+    _mm_storeu_ps(lanesData, relevanceLanes);
+    sums.relevance += lanesData[0] + lanesData[1] + lanesData[2] + lanesData[3];
+
+    return col;
+}
+#endif
+
+#ifdef LATTE_AVX2_KERNELS
+//! same as the SSE2 kernel with 8 pixels per step
+LATTE_AVX2_TARGET int brightnessSumAvx2(const QRgb *line, int count, quint64 &sum)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i weights = _mm256_setr_epi16(BLUEWEIGHT, GREENWEIGHT, REDWEIGHT, 0, BLUEWEIGHT, GREENWEIGHT, REDWEIGHT, 0,
+                                              BLUEWEIGHT, GREENWEIGHT, REDWEIGHT, 0, BLUEWEIGHT, GREENWEIGHT, REDWEIGHT, 0);
+    const int vectorEnd = count - (count % 8);
+    int col{0};
+
+    while (col < vectorEnd) {
+        const int chunkEnd = qMin(vectorEnd, col + MAXLANEPIXELS);
+        __m256i lanes = _mm256_setzero_si256();
+
+        for (; col < chunkEnd; col += 8) {
+            const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(line + col));
+            lanes = _mm256_add_epi32(lanes, _mm256_madd_epi16(_mm256_unpacklo_epi8(pixels, zero), weights));
+            lanes = _mm256_add_epi32(lanes, _mm256_madd_epi16(_mm256_unpackhi_epi8(pixels, zero), weights));
+        }
+
+        qint32 lanesData[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanesData), lanes);
+
+        for (int i = 0; i < 8; ++i) {
+            sum += (quint64)lanesData[i];
+        }
+    }
+
+    return col;
+}
+
+LATTE_AVX2_TARGET int weightedSumsAvx2(const QRgb *line, int count, WeightedSums &sums)
+{
+    const __m256i channelMask = _mm256_set1_epi32(0xff);
+    const __m256 inverted255 = _mm256_set1_ps(1.0f / 255.0f);
+    const __m256 minRelevance = _mm256_set1_ps(.1f);
+    const __m256 relevanceFactor = _mm256_set1_ps(.9f);
+
+    __m256 rlanes = _mm256_setzero_ps();
+    __m256 glanes = _mm256_setzero_ps();
+    __m256 blanes = _mm256_setzero_ps();
+    __m256 relevanceLanes = _mm256_setzero_ps();
+
+    const int vectorEnd = count - (count % 8);
+    int col{0};
+
+    for (; col < vectorEnd; col += 8) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(line + col));
+
+        const __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(pixels, channelMask));
+        const __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), channelMask));
+        const __m256 r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), channelMask));
+        const __m256 a = _mm256_cvtepi32_ps(_mm256_srli_epi32(pixels, 24));
+
+        const __m256 maxChannel = _mm256_max_ps(r, _mm256_max_ps(g, b));
+        const __m256 minChannel = _mm256_min_ps(r, _mm256_min_ps(g, b));
+        const __m256 saturation = _mm256_mul_ps(_mm256_sub_ps(maxChannel, minChannel), inverted255);
+        const __m256 relevance = _mm256_add_ps(minRelevance,
+                                               _mm256_mul_ps(relevanceFactor, _mm256_mul_ps(_mm256_mul_ps(a, inverted255), saturation)));
+
+        rlanes = _mm256_add_ps(rlanes, _mm256_mul_ps(r, relevance));
+        glanes = _mm256_add_ps(glanes, _mm256_mul_ps(g, relevance));
+        blanes = _mm256_add_ps(blanes, _mm256_mul_ps(b, relevance));
+        relevanceLanes = _mm256_add_ps(relevanceLanes, relevance);
+    }
+
+    float lanesData[8];
+
+    _mm256_storeu_ps(lanesData, rlanes);
+    for (int i = 0; i < 8; ++i) {
+        sums.r += lanesData[i];
+    }
+
+    _mm256_storeu_ps(lanesData, glanes);
+    for (int i = 0; i < 8; ++i) {
+        sums.g += lanesData[i];
+    }
+
+    _mm256_storeu_ps(lanesData, blanes);
+    for (int i = 0; i < 8; ++i) {
+        sums.b += lanesData[i];
+    }
+
+    _mm256_storeu_ps(lanesData, relevanceLanes);
+    for (int i = 0; i < 8; ++i) {
+        sums.relevance += lanesData[i];
+    }
+
+    return col;
+}
+#endif
+
+//! sum of colorBrightness()*1000 for count pixels
+quint64 brightnessSum(const QRgb *line, int count)
+{
+    quint64 sum{0};
+    int col{0};
+
+#ifdef LATTE_AVX2_KERNELS
+    if (hasAvx2()) {
+        col = brightnessSumAvx2(line, count, sum);
+    }
+#endif
+
+#ifdef LATTE_SSE2_KERNELS
+    col += brightnessSumSse2(line + col, count - col, sum);
+#endif
+
+    for (; col < count; ++col) {
+        const QRgb pix = line[col];
+        sum += qRed(pix) * REDWEIGHT + qGreen(pix) * GREENWEIGHT + qBlue(pix) * BLUEWEIGHT;
+    }
+
+    return sum;
+}
+
+//! weighted channels for count pixels, every pixel is weighted by its alpha and saturation
+void weightedSums(const QRgb *line, int count, WeightedSums &sums)
+{
+    int col{0};
+
+#ifdef LATTE_AVX2_KERNELS
+    if (hasAvx2()) {
+        col = weightedSumsAvx2(line, count, sums);
+    }
+#endif
+
+#ifdef LATTE_SSE2_KERNELS
+    col += weightedSumsSse2(line + col, count - col, sums);
+#endif
+
+    for (; col < count; ++col) {
+        const QRgb pix = line[col];
+
+        int r = qRed(pix);
+        int g = qGreen(pix);
+        int b = qBlue(pix);
+        int a = qAlpha(pix);
+
+        float saturation = (qMax(r, qMax(g, b)) - qMin(r, qMin(g, b))) / 255.0f;
+        float relevance = .1 + .9 * (a / 255.0f) * saturation;
+
+        sums.r += (float)(r * relevance);
+        sums.g += (float)(g * relevance);
+        sums.b += (float)(b * relevance);
+
+        sums.relevance += relevance;
+    }
+}
+}
+
 float colorBrightness(QColor color)
 {
     return colorBrightness(color.red(), color.green(), color.blue());
@@ -73,6 +363,55 @@ float colorLumina(float r, float g, float b)
     return luminosity;
 }
 
+float areaBrightness(const QImage &image, const QRect &area)
+{
+    const QRect validArea = area.intersected(image.rect());
+
+    if (image.isNull() || validArea.isEmpty()) {
+        return -1000;
+    }
+
+    const QImage source = argb32Image(image);
+    quint64 sum{0};
+
+    for (int row = validArea.top(); row <= validArea.bottom(); ++row) {
+        const QRgb *line = (const QRgb *)source.constScanLine(row);
+        sum += brightnessSum(line + validArea.left(), validArea.width());
+    }
+
+    const qreal pixels = (qreal)validArea.width() * validArea.height();
+
+    return (float)(sum / (1000 * pixels));
+}
+
+QColor weightedAverageColor(const QImage &image)
+{
+    if (image.isNull()) {
+        return QColor();
+    }
+
+    const QImage source = argb32Image(image);
+    WeightedSums sums;
+
+    for (int row = 0; row < source.height(); ++row) {
+        weightedSums((const QRgb *)source.constScanLine(row), source.width(), sums);
+    }
+
+    if (sums.relevance <= 0) {
+        return QColor();
+    }
+
+    return QColor(qBound(0, (int)(sums.r / sums.relevance), 255),
+                  qBound(0, (int)(sums.g / sums.relevance), 255),
+                  qBound(0, (int)(sums.b / sums.relevance), 255));
+}
+
+bool setAvx2KernelsEnabled(bool enabled)
+{
+    s_avx2KernelsEnabled = enabled;
+    return hasAvx2();
+}
+
 QString standardPath(QString subPath, bool localfirst)
 {
     QStringList paths = QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation);
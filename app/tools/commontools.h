@@ -23,6 +23,8 @@
 
 // Qt
 #include <QColor>
+#include <QImage>
+#include <QRect>
 
 namespace Latte {
 
@@ -34,6 +36,20 @@ float colorLumina(QColor color);
 float colorLumina(QRgb rgb);
 float colorLumina(float r, float g, float b);
 
+//! average colorBrightness() of the pixels in the image area, returns -1000 for
+//! invalid images or empty areas. Images that are not 32bit are converted first,
+//! so callers that scan many areas should provide 32bit images
+float areaBrightness(const QImage &image, const QRect &area);
+
+//! average color of the image in which every pixel is weighted by its
+//! alpha and saturation, it is used to identify an image dominant color.
+//! returns an invalid color for invalid images
+QColor weightedAverageColor(const QImage &image);
+
+//! internal, autotests disable the AVX2 kernels in order to verify the SSE2
+//! ones on cpus that support AVX2. It returns whether AVX2 kernels are used
+bool setAvx2KernelsEnabled(bool enabled);
+
 //! returns the standard path found that contains the subPath
 //! local paths have higher priority by default
 QString standardPath(QString subPath, bool localFirst = true);
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RECENTLYUSED_H
+#define RECENTLYUSED_H
+
+// C++
+#include <list>
+
+// Qt
+#include <QHash>
+#include <QList>
+#include <QtGlobal>
+
+namespace Latte {
+
+//! Keeps keys ordered from least to most recently used. Touching, removing
+//! and taking the least recently used key are constant time operations.
+//! The index holds iterators of the keys list and it can not be copied
+template <class Key>
+class RecentlyUsed
+{
+
+public:
+    RecentlyUsed() = default;
+
+    int count() const
+    {
+        return m_positions.count();
+    }
+
+    bool isEmpty() const
+    {
+        return m_positions.isEmpty();
+    }
+
+    bool contains(const Key &key) const
+    {
+        return m_positions.contains(key);
+    }
+
+    //! marks key as the most recently used one
+    void touch(const Key &key)
+    {
+        auto position = m_positions.find(key);
+
+        if (position != m_positions.end()) {
+            m_keys.splice(m_keys.end(), m_keys, position.value());
+            return;
+        }
+
+        m_positions.insert(key, m_keys.insert(m_keys.end(), key));
+    }
+
+    void remove(const Key &key)
+    {
+        auto position = m_positions.find(key);
+
+        if (position == m_positions.end()) {
+            return;
+        }
+
+        m_keys.erase(position.value());
+        m_positions.erase(position);
+    }
+
+    Key takeLeastRecent()
+    {
+        Key key = m_keys.front();
+        m_keys.pop_front();
+        m_positions.remove(key);
+
+        return key;
+    }
+
+    void clear()
+    {
+        m_keys.clear();
+        m_positions.clear();
+    }
+
+    //! keys from least to most recently used
+    QList<Key> keys() const
+    {
+        QList<Key> result;
+        result.reserve(m_positions.count());
+
+        for (const auto &key : m_keys) {
+            result << key;
+        }
+
+        return result;
+    }
+
+private:
+    Q_DISABLE_COPY(RecentlyUsed)
+
+private:
+    std::list<Key> m_keys;
+    QHash<Key, typename std::list<Key>::iterator> m_positions;
+};
+
+}
+
+#endif
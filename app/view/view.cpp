@@ -1165,6 +1165,12 @@ void View::setLayout(Layout::GenericLayout *layout)
                 }
             });
 
+            connectionsLayout << connect(m_layout, &Layout::GenericLayout::appliedActivitiesChanged, this, [&]() {
+                if (m_layout) {
+                    setActivities(m_layout->appliedActivities());
+                }
+            });
+
             connectionsLayout << connect(latteCorona->layoutsManager()->synchronizer(), &Layouts::Synchronizer::layoutsChanged, this, [&]() {
                 if (m_layout) {
                     setActivities(m_layout->appliedActivities());
@@ -60,27 +60,9 @@ void  AllScreensTracker::init()
         }
     });
 
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::activeWindowMaximizedChangedForLayout, this, [&](const Latte::Layout::GenericLayout *layout) {
+    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::snapshotChangedForLayout, this, [&](const Latte::Layout::GenericLayout *layout, int changedFields) {
         if (m_latteView->layout() == layout) {
-            emit activeWindowMaximizedChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::existsWindowActiveChangedForLayout, this, [&](const Latte::Layout::GenericLayout *layout) {
-        if (m_latteView->layout() == layout) {
-            emit existsWindowActiveChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::existsWindowMaximizedChangedForLayout, this, [&](const Latte::Layout::GenericLayout *layout) {
-        if (m_latteView->layout() == layout) {
-            emit existsWindowMaximizedChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::activeWindowSchemeChangedForLayout, this, [&](const Latte::Layout::GenericLayout *layout) {
-        if (m_latteView->layout() == layout) {
-            emit activeWindowSchemeChanged();
+            updateSnapshot(changedFields);
         }
     });
 }
@@ -88,6 +70,7 @@ void  AllScreensTracker::init()
 void AllScreensTracker::initSignalsForInformation()
 {
     m_currentLastActiveWindow = lastActiveWindow();
+    m_snapshot = m_wm->windowsTracker()->snapshot(m_latteView->layout());
 
     emit lastActiveWindowChanged();
     emit activeWindowMaximizedChanged();
@@ -96,24 +79,47 @@ void AllScreensTracker::initSignalsForInformation()
     emit activeWindowSchemeChanged();
 }
 
+void AllScreensTracker::updateSnapshot(int changedFields)
+{
+    using WindowSystem::Tracker::TrackingSnapshot;
+
+    m_snapshot = m_wm->windowsTracker()->snapshot(m_latteView->layout());
+
+    if (changedFields & TrackingSnapshot::ActiveWindowMaximizedField) {
+        emit activeWindowMaximizedChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ExistsWindowActiveField) {
+        emit existsWindowActiveChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ExistsWindowMaximizedField) {
+        emit existsWindowMaximizedChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ActiveWindowSchemeField) {
+        emit activeWindowSchemeChanged();
+    }
+}
+
 bool AllScreensTracker::activeWindowMaximized() const
 {
-    return m_wm->windowsTracker()->activeWindowMaximized(m_latteView->layout());
+    return m_snapshot.activeWindowMaximized;
 }
 
 bool AllScreensTracker::existsWindowActive() const
 {
-    return m_wm->windowsTracker()->existsWindowActive(m_latteView->layout());
+    return m_snapshot.existsWindowActive;
 }
 
 bool AllScreensTracker::existsWindowMaximized() const
 {
-    return m_wm->windowsTracker()->existsWindowMaximized(m_latteView->layout());
+    return m_snapshot.existsWindowMaximized;
 }
 
 WindowSystem::SchemeColors *AllScreensTracker::activeWindowScheme() const
 {
-    return m_wm->windowsTracker()->activeWindowScheme(m_latteView->layout());
+    return m_snapshot.activeWindowScheme;
 }
 
 WindowSystem::Tracker::LastActiveWindow *AllScreensTracker::lastActiveWindow()
@@ -60,69 +60,17 @@ void  CurrentScreenTracker::init()
         }
     });
 
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::activeWindowMaximizedChanged, this, [&](const Latte::View *view) {
+    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::snapshotChanged, this, [&](const Latte::View *view, int changedFields) {
         if (m_latteView == view) {
-            emit activeWindowMaximizedChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::activeWindowTouchingChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit activeWindowTouchingChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::activeWindowTouchingEdgeChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit activeWindowTouchingEdgeChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::existsWindowActiveChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit existsWindowActiveChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::existsWindowMaximizedChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit existsWindowMaximizedChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::existsWindowTouchingChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit existsWindowTouchingChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::existsWindowTouchingEdgeChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit existsWindowTouchingEdgeChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::isTouchingBusyVerticalViewChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit isTouchingBusyVerticalViewChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::activeWindowSchemeChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit activeWindowSchemeChanged();
-        }
-    });
-
-    connect(m_wm->windowsTracker(), &WindowSystem::Tracker::Windows::touchingWindowSchemeChanged, this, [&](const Latte::View *view) {
-        if (m_latteView == view) {
-            emit touchingWindowSchemeChanged();
+            updateSnapshot(changedFields);
         }
     });
 }
 
 void CurrentScreenTracker::initSignalsForInformation()
 {
+    m_snapshot = m_wm->windowsTracker()->snapshot(m_latteView);
+
     emit lastActiveWindowChanged();
     emit activeWindowMaximizedChanged();
     emit activeWindowTouchingChanged();
@@ -135,54 +83,101 @@ void CurrentScreenTracker::initSignalsForInformation()
     emit touchingWindowSchemeChanged();
 }
 
+void CurrentScreenTracker::updateSnapshot(int changedFields)
+{
+    using WindowSystem::Tracker::TrackingSnapshot;
+
+    m_snapshot = m_wm->windowsTracker()->snapshot(m_latteView);
+
+    if (changedFields & TrackingSnapshot::ActiveWindowMaximizedField) {
+        emit activeWindowMaximizedChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ActiveWindowTouchingField) {
+        emit activeWindowTouchingChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ActiveWindowTouchingEdgeField) {
+        emit activeWindowTouchingEdgeChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ExistsWindowActiveField) {
+        emit existsWindowActiveChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ExistsWindowMaximizedField) {
+        emit existsWindowMaximizedChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ExistsWindowTouchingField) {
+        emit existsWindowTouchingChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ExistsWindowTouchingEdgeField) {
+        emit existsWindowTouchingEdgeChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::IsTouchingBusyVerticalViewField) {
+        emit isTouchingBusyVerticalViewChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::ActiveWindowSchemeField) {
+        emit activeWindowSchemeChanged();
+    }
+
+    if (changedFields & TrackingSnapshot::TouchingWindowSchemeField) {
+        emit touchingWindowSchemeChanged();
+    }
+}
+
 bool CurrentScreenTracker::activeWindowMaximized() const
 {
-    return m_wm->windowsTracker()->activeWindowMaximized(m_latteView);
+    return m_snapshot.activeWindowMaximized;
 }
 
 bool CurrentScreenTracker::activeWindowTouching() const
 {
-    return m_wm->windowsTracker()->activeWindowTouching(m_latteView);
+    return m_snapshot.activeWindowTouching;
 }
 
 bool CurrentScreenTracker::activeWindowTouchingEdge() const
 {
-    return m_wm->windowsTracker()->activeWindowTouchingEdge(m_latteView);
+    return m_snapshot.activeWindowTouchingEdge;
 }
 
 bool CurrentScreenTracker::existsWindowActive() const
 {
-    return m_wm->windowsTracker()->existsWindowActive(m_latteView);
+    return m_snapshot.existsWindowActive;
 }
 
 bool CurrentScreenTracker::existsWindowMaximized() const
 {
-    return m_wm->windowsTracker()->existsWindowMaximized(m_latteView);
+    return m_snapshot.existsWindowMaximized;
 }
 
 bool CurrentScreenTracker::existsWindowTouching() const
 {
-    return m_wm->windowsTracker()->existsWindowTouching(m_latteView);
+    return m_snapshot.existsWindowTouching;
 }
 
 bool CurrentScreenTracker::existsWindowTouchingEdge() const
 {
-    return m_wm->windowsTracker()->existsWindowTouchingEdge(m_latteView);
+    return m_snapshot.existsWindowTouchingEdge;
 }
 
 bool CurrentScreenTracker::isTouchingBusyVerticalView() const
 {
-    return m_wm->windowsTracker()->isTouchingBusyVerticalView(m_latteView);
+    return m_snapshot.isTouchingBusyVerticalView;
 }
 
 WindowSystem::SchemeColors *CurrentScreenTracker::activeWindowScheme() const
 {
-    return m_wm->windowsTracker()->activeWindowScheme(m_latteView);
+    return m_snapshot.activeWindowScheme;
 }
 
 WindowSystem::SchemeColors *CurrentScreenTracker::touchingWindowScheme() const
 {
-    return m_wm->windowsTracker()->touchingWindowScheme(m_latteView);
+    return m_snapshot.touchingWindowScheme;
 }
 
 WindowSystem::Tracker::LastActiveWindow *CurrentScreenTracker::lastActiveWindow()
@@ -22,6 +22,7 @@
 
 // local
 #include "../../wm/abstractwindowinterface.h"
+#include "../../wm/tracker/trackingsnapshot.h"
 
 // Qt
 #include <QObject>
@@ -100,6 +101,7 @@ signals:
 
 private slots:
     void initSignalsForInformation();
+    void updateSnapshot(int changedFields);
 
 private:
     void init();
@@ -107,6 +109,9 @@ private:
 private:
     Latte::View *m_latteView{nullptr};
     WindowSystem::AbstractWindowInterface *m_wm{nullptr};
+
+    //! last tracking state that was published for this view
+    WindowSystem::Tracker::TrackingSnapshot m_snapshot;
 };
 
 }
@@ -53,9 +53,19 @@ AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
     m_windowWaitingTimer.setSingleShot(true);
 
     connect(&m_windowWaitingTimer, &QTimer::timeout, this, [&]() {
-        WindowId wid = m_windowChangedWaiting;
-        m_windowChangedWaiting = QVariant();
-        emit windowChanged(wid);
+        QList<WindowId> wids = m_changedWindows;
+        QList<int> changes;
+
+        for (const auto &wid : wids) {
+            changes << m_changedWindowsProperties.value(wid, AllChanges);
+        }
+
+        m_changedWindows.clear();
+        m_changedWindowsProperties.clear();
+
+        if (!wids.isEmpty()) {
+            emit windowsChanged(wids, changes);
+        }
     });
 
     connect(this, &AbstractWindowInterface::windowRemoved, this, &AbstractWindowInterface::windowRemovedSlot);
@@ -68,7 +78,6 @@ AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
         m_currentActivity = id;
         emit currentActivityChanged();
     });
-
 }
 
 AbstractWindowInterface::~AbstractWindowInterface()
@@ -104,6 +113,17 @@ Tracker::Windows *AbstractWindowInterface::windowsTracker() const
     return m_windowsTracker;
 }
 
+QList<WindowInfoWrap> AbstractWindowInterface::requestInfoBatch(const QList<WindowId> &wids)
+{
+    QList<WindowInfoWrap> infos;
+
+    for (const auto &wid : wids) {
+        infos << requestInfo(wid);
+    }
+
+    return infos;
+}
+
 bool AbstractWindowInterface::isIgnored(const WindowId &wid) const
 {
     return m_ignoredWindows.contains(wid);
@@ -182,7 +202,10 @@ bool AbstractWindowInterface::isSidepanel(const QRect &wGeometry) const
 
 bool AbstractWindowInterface::hasBlockedTracking(const WindowId &wid) const
 {
-    return (!isWhitelistedWindow(wid) && (isRegisteredPlasmaIgnoredWindow(wid) || isIgnored(wid)));
+    const WindowHandle handle(wid);
+
+    return (!m_whitelistedWindows.contains(handle)
+            && (m_plasmaIgnoredWindows.contains(handle) || m_ignoredWindows.contains(handle)));
 }
 
 bool AbstractWindowInterface::isRegisteredPlasmaIgnoredWindow(const WindowId &wid) const
@@ -195,16 +218,41 @@ bool AbstractWindowInterface::isWhitelistedWindow(const WindowId &wid) const
     return m_whitelistedWindows.contains(wid);
 }
 
+void AbstractWindowInterface::updateCurrentMasks()
+{
+    //! masks are validated against the ids they were calculated from, this way
+    //! they are always correct no matter which slot of currentDesktopChanged()
+    //! or currentActivityChanged() is called first
+    if (!m_currentMasksInitialized || m_currentDesktopMaskId != m_currentDesktop) {
+        m_currentDesktopMaskId = m_currentDesktop;
+        m_currentDesktopMask = MembershipIds::desktops()->mask(m_currentDesktop);
+    }
+
+    if (!m_currentMasksInitialized || m_currentActivityMaskId != m_currentActivity) {
+        m_currentActivityMaskId = m_currentActivity;
+        m_currentActivityMask = MembershipIds::activities()->mask(m_currentActivity);
+    }
+
+    m_currentMasksInitialized = true;
+}
+
 bool AbstractWindowInterface::inCurrentDesktopActivity(const WindowInfoWrap &winfo)
 {
-    return (winfo.isValid() && winfo.isOnDesktop(currentDesktop()) && winfo.isOnActivity(currentActivity()));
+    if (!winfo.isValid()) {
+        return false;
+    }
+
+    updateCurrentMasks();
+
+    return (winfo.isOnDesktop(m_currentDesktopMask, m_currentDesktop)
+            && winfo.isOnActivity(m_currentActivityMask, m_currentActivity));
 }
 
 //! Register Latte Ignored Windows in order to NOT be tracked
 void AbstractWindowInterface::registerIgnoredWindow(WindowId wid)
 {
     if (!wid.isNull() && !m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.append(wid);
+        m_ignoredWindows.insert(wid);
         emit windowChanged(wid);
     }
 }
@@ -212,7 +260,7 @@ void AbstractWindowInterface::registerIgnoredWindow(WindowId wid)
 void AbstractWindowInterface::unregisterIgnoredWindow(WindowId wid)
 {
     if (m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.removeAll(wid);
+        m_ignoredWindows.remove(wid);
         emit windowRemoved(wid);
     }
 }
@@ -220,7 +268,7 @@ void AbstractWindowInterface::unregisterIgnoredWindow(WindowId wid)
 void AbstractWindowInterface::registerPlasmaIgnoredWindow(WindowId wid)
 {
     if (!wid.isNull() && !m_plasmaIgnoredWindows.contains(wid)) {
-        m_plasmaIgnoredWindows.append(wid);
+        m_plasmaIgnoredWindows.insert(wid);
         emit windowChanged(wid);
     }
 }
@@ -228,14 +276,14 @@ void AbstractWindowInterface::registerPlasmaIgnoredWindow(WindowId wid)
 void AbstractWindowInterface::unregisterPlasmaIgnoredWindow(WindowId wid)
 {
     if (m_plasmaIgnoredWindows.contains(wid)) {
-        m_plasmaIgnoredWindows.removeAll(wid);
+        m_plasmaIgnoredWindows.remove(wid);
     }
 }
 
 void AbstractWindowInterface::registerWhitelistedWindow(WindowId wid)
 {
     if (!wid.isNull() && !m_whitelistedWindows.contains(wid)) {
-        m_whitelistedWindows.append(wid);
+        m_whitelistedWindows.insert(wid);
         emit windowChanged(wid);
     }
 }
@@ -243,12 +291,17 @@ void AbstractWindowInterface::registerWhitelistedWindow(WindowId wid)
 void AbstractWindowInterface::unregisterWhitelistedWindow(WindowId wid)
 {
     if (m_whitelistedWindows.contains(wid)) {
-        m_whitelistedWindows.removeAll(wid);
+        m_whitelistedWindows.remove(wid);
     }
 }
 
 void AbstractWindowInterface::windowRemovedSlot(WindowId wid)
 {
+    if (m_changedWindowsProperties.contains(wid)) {
+        m_changedWindowsProperties.remove(wid);
+        m_changedWindows.removeAll(wid);
+    }
+
     if (m_plasmaIgnoredWindows.contains(wid)) {
         unregisterPlasmaIgnoredWindow(wid);
     }
@@ -260,6 +313,16 @@ void AbstractWindowInterface::windowRemovedSlot(WindowId wid)
     if (m_whitelistedWindows.contains(wid)) {
         unregisterWhitelistedWindow(wid);
     }
+
+    //! the rest windowRemoved receivers must still find the same handle,
+    //! windows that were added again in the meantime keep their handle
+    if (WindowHandle(wid).isInterned()) {
+        QTimer::singleShot(0, this, [this, wid]() {
+            if (!windowsTracker()->isValidFor(wid)) {
+                WindowHandle::release(wid);
+            }
+        });
+    }
 }
 
 //! Activities switching
@@ -300,29 +363,20 @@ void AbstractWindowInterface::switchToPreviousActivity()
 }
 
 //! Delay window changed trigerring
-void AbstractWindowInterface::considerWindowChanged(WindowId wid)
+void AbstractWindowInterface::considerWindowChanged(WindowId wid, int changes)
 {
-    //! Consider if the windowChanged signal should be sent DIRECTLY or WAIT
-
-    if (m_windowChangedWaiting == wid && m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowWaitingTimer.start();
-        return;
+    //! Accumulate the window and its changed properties, all waiting
+    //! windows are sent together when the timer triggers
+    const WindowHandle handle(wid);
+
+    if (m_changedWindowsProperties.contains(handle)) {
+        m_changedWindowsProperties[handle] |= changes;
+    } else {
+        m_changedWindows << wid;
+        m_changedWindowsProperties[handle] = changes;
     }
 
-    if (m_windowChangedWaiting != wid && !m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowChangedWaiting = wid;
-        m_windowWaitingTimer.start();
-    }
-
-    if (m_windowChangedWaiting != wid && m_windowWaitingTimer.isActive()) {
-        m_windowWaitingTimer.stop();
-        //! sent previous waiting window
-        emit windowChanged(m_windowChangedWaiting);
-
-        //! retrigger waiting for the upcoming window
-        m_windowChangedWaiting = wid;
+    if (!m_windowWaitingTimer.isActive()) {
         m_windowWaitingTimer.start();
     }
 }
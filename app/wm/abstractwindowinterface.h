@@ -23,6 +23,7 @@
 
 // local
 #include <coretypes.h>
+#include "appdataresolver.h"
 #include "schemecolors.h"
 #include "tasktools.h"
 #include "windowinfowrap.h"
@@ -36,11 +37,13 @@
 #include <QObject>
 #include <QWindow>
 #include <QDialog>
+#include <QHash>
 #include <QMap>
 #include <QRect>
 #include <QPoint>
 #include <QPointer>
 #include <QScreen>
+#include <QSet>
 #include <QTimer>
 
 // KDE
@@ -78,6 +81,20 @@ public:
         Right,
     };
 
+    //! window properties that changed, used when coalescing window changes
+    enum WindowChange
+    {
+        NoChange = 0x00,
+        StateChange = 0x01,
+        GeometryChange = 0x02,
+        ActiveChange = 0x04,
+        DesktopChange = 0x08,
+        ActivitiesChange = 0x10,
+        ParentChange = 0x20,
+        NameChange = 0x40,
+        AllChanges = 0x7F
+    };
+
     explicit AbstractWindowInterface(QObject *parent = nullptr);
     virtual ~AbstractWindowInterface();
 
@@ -91,6 +108,9 @@ public:
     virtual WindowId activeWindow() = 0;
     virtual WindowInfoWrap requestInfo(WindowId wid) = 0;
     virtual WindowInfoWrap requestInfoActive() = 0;
+    //! information for many windows at once, the returned list follows the provided windows order.
+    //! Window systems that can fetch windows properties in parallel should override it
+    virtual QList<WindowInfoWrap> requestInfoBatch(const QList<WindowId> &wids);
 
     virtual void skipTaskBar(const QDialog &dialog) = 0;
     virtual void slideWindow(QWindow &view, Slide location) = 0;
@@ -114,6 +134,8 @@ public:
     virtual WindowId winIdFor(QString appId, QRect geometry) = 0;
     virtual WindowId winIdFor(QString appId, QString title) = 0;
     virtual AppData appDataFor(WindowId wid) = 0;
+    //! cheap, it is used in order to resolve application data asynchronously
+    virtual AppMetadata appMetadataFor(WindowId wid) = 0;
 
     bool inCurrentDesktopActivity(const WindowInfoWrap &winfo);
 
@@ -147,6 +169,8 @@ public:
 signals:
     void activeWindowChanged(WindowId wid);
     void windowChanged(WindowId winfo);
+    //! coalesced window changes, for each window its changed properties are provided as WindowChange flags
+    void windowsChanged(const QList<WindowId> &wids, const QList<int> &changes);
     void windowAdded(WindowId wid);
     void windowRemoved(WindowId wid);
     void currentDesktopChanged();
@@ -160,25 +184,27 @@ protected:
 
     //! windows that must be ignored from tracking, a good example are Latte::Views and
     //! their Configuration windows
-    QList<WindowId> m_ignoredWindows;
+    QSet<WindowHandle> m_ignoredWindows;
     //! identified plasma panels
-    QList<WindowId> m_plasmaIgnoredWindows;
+    QSet<WindowHandle> m_plasmaIgnoredWindows;
 
     //! identified whitelisted windows that can be tracked e.g. plasma widgets explorer and activities
-    QList<WindowId> m_whitelistedWindows;
+    QSet<WindowHandle> m_whitelistedWindows;
 
     QPointer<KActivities::Consumer> m_activities;
 
     //! Sending too fast plenty of signals for the same window
-    //! has no reason and can create HIGH CPU usage. This Timer
-    //! can delay the batch sending of signals for the same window
-    WindowId m_windowChangedWaiting;
+    //! has no reason and can create HIGH CPU usage. Changed windows
+    //! are accumulated together with their changed properties and this
+    //! Timer sends them as one batch
+    QList<WindowId> m_changedWindows;
+    QHash<WindowHandle, int> m_changedWindowsProperties;
     QTimer m_windowWaitingTimer;
 
     //! Plasma taskmanager rules ile
     KSharedConfig::Ptr rulesConfig;
 
-    void considerWindowChanged(WindowId wid);
+    void considerWindowChanged(WindowId wid, int changes = AllChanges);
 
     bool isIgnored(const WindowId &wid) const;
     bool isRegisteredPlasmaIgnoredWindow(const WindowId &wid) const;
@@ -192,6 +218,18 @@ private slots:
     void windowRemovedSlot(WindowId wid);
 
 private:
+    void updateCurrentMasks();
+
+private:
+    //! current desktop and activity as MembershipIds masks together with the ids
+    //! they were calculated from, they are recalculated only when these ids differ
+    //! from the current desktop or activity
+    bool m_currentMasksInitialized{false};
+    QString m_currentDesktopMaskId;
+    QString m_currentActivityMaskId;
+    quint64 m_currentDesktopMask{0};
+    quint64 m_currentActivityMask{0};
+
     Latte::Corona *m_corona;
     Tracker::Schemes *m_schemesTracker;
     Tracker::Windows *m_windowsTracker;
@@ -0,0 +1,414 @@
+/*
+*  Copyright 2026  agent <agent@local>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "appdataresolver.h"
+
+// Qt
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QPair>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+// KDE
+#include <KDesktopFile>
+#include <KDirWatch>
+#include <KService>
+#include <KSycoca>
+
+namespace Latte {
+namespace WindowSystem {
+
+#define MAXRESOLVERTHREADS 2
+#define MAXWINDOWURLS 200
+#define MAXCACHEDURLS 300
+
+//! increase it when the cache format or the urls resolution changes
+#define CACHEVERSION 2
+#define CACHEFILE "lattedock/windowurls.cache"
+#define RULESCONFIG "taskmanagerrulesrc"
+
+class AppDataResolveJob : public QRunnable
+{
+public:
+    AppDataResolveJob(AppDataResolver *resolver, const QString &key, const AppMetadata &metadata)
+        : m_resolver(resolver),
+          m_key(key),
+          m_metadata(metadata)
+    {
+    }
+
+    void run() override
+    {
+        m_resolver->resolve(m_key, m_metadata);
+    }
+
+private:
+    AppDataResolver *m_resolver{nullptr};
+    QString m_key;
+    AppMetadata m_metadata;
+};
+
+AppDataResolver::AppDataResolver(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(MAXRESOLVERTHREADS);
+
+    //! urls are resolved in worker threads and are delivered in the gui thread
+    connect(this, &AppDataResolver::urlResolved, this, &AppDataResolver::onUrlResolved, Qt::QueuedConnection);
+
+    connect(KSycoca::self(), static_cast<void (KSycoca::*)()>(&KSycoca::databaseChanged), this, &AppDataResolver::clearCache);
+
+    //! task manager rules can be edited at runtime
+    m_rulesFiles = QStandardPaths::locateAll(QStandardPaths::GenericConfigLocation, QStringLiteral(RULESCONFIG));
+    const QString userRulesFile = QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation)
+            + QLatin1Char('/') + QStringLiteral(RULESCONFIG);
+
+    if (!m_rulesFiles.contains(userRulesFile)) {
+        m_rulesFiles << userRulesFile;
+    }
+
+    for (const auto &file : m_rulesFiles) {
+        KDirWatch::self()->addFile(file);
+    }
+
+    connect(KDirWatch::self(), &KDirWatch::dirty, this, &AppDataResolver::onRulesFileChanged);
+    connect(KDirWatch::self(), &KDirWatch::created, this, &AppDataResolver::onRulesFileChanged);
+    connect(KDirWatch::self(), &KDirWatch::deleted, this, &AppDataResolver::onRulesFileChanged);
+
+    //! resolved urls are written in batches
+    m_saveCacheTimer.setInterval(5000);
+    m_saveCacheTimer.setSingleShot(true);
+    connect(&m_saveCacheTimer, &QTimer::timeout, this, &AppDataResolver::saveCache);
+
+    m_cacheTimestamp = cacheDependenciesTimestamp();
+    loadCache();
+}
+
+AppDataResolver::~AppDataResolver()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+
+    saveCache();
+}
+
+QString AppDataResolver::metadataKey(const AppMetadata &metadata)
+{
+    return metadata.appId + QLatin1Char('|') + metadata.wmClassName + QLatin1Char('|')
+            + metadata.desktopFileName + QLatin1Char('|') + QString::number(metadata.pid);
+}
+
+bool AppDataResolver::contains(const AppMetadata &metadata) const
+{
+    return m_windowUrls.contains(metadataKey(metadata));
+}
+
+AppData AppDataResolver::appData(const AppMetadata &metadata)
+{
+    QString key = metadataKey(metadata);
+
+    if (!m_windowUrls.contains(key)) {
+        return AppData();
+    }
+
+    m_windowUrlsUsage.touch(key);
+
+    return m_appData.value(m_windowUrls[key]);
+}
+
+void AppDataResolver::insertWindowUrl(const QString &key, const QUrl &url)
+{
+    m_windowUrls[key] = url;
+    m_windowUrlsUsage.touch(key);
+
+    while (m_windowUrlsUsage.count() > MAXWINDOWURLS) {
+        m_windowUrls.remove(m_windowUrlsUsage.takeLeastRecent());
+    }
+}
+
+void AppDataResolver::insertUrl(const QString &urlKey, const QUrl &url)
+{
+    m_urls[urlKey] = url;
+    m_urlsUsage.touch(urlKey);
+    m_urlsChanged = true;
+
+    while (m_urlsUsage.count() > MAXCACHEDURLS) {
+        m_urls.remove(m_urlsUsage.takeLeastRecent());
+    }
+}
+
+void AppDataResolver::requestAppData(const WindowId &wid, const AppMetadata &metadata)
+{
+    QString key = metadataKey(metadata);
+
+    if (m_windowUrls.contains(key)) {
+        emit appDataResolved(wid, appData(metadata));
+        return;
+    }
+
+    if (m_pendingWindows.contains(key)) {
+        //! the same application is already being resolved
+        if (!m_pendingWindows[key].contains(wid)) {
+            m_pendingWindows[key] << wid;
+        }
+
+        return;
+    }
+
+    m_pendingWindows[key] << wid;
+    m_pool.start(new AppDataResolveJob(this, key, metadata));
+}
+
+void AppDataResolver::resolve(const QString &key, const AppMetadata &metadata)
+{
+    //! windows of the same application share the same metadata and command line
+    QString commandLine = commandLineFromPid(metadata.pid);
+    QString urlKey = metadata.appId + QLatin1Char('|') + metadata.wmClassName + QLatin1Char('|')
+            + metadata.desktopFileName + QLatin1Char('|') + (commandLine.isEmpty() ? QString::number(metadata.pid) : commandLine);
+    int cacheGeneration{0};
+
+    {
+        QMutexLocker locker(&m_urlsMutex);
+        cacheGeneration = m_cacheGeneration;
+
+        if (m_urls.contains(urlKey)) {
+            m_urlsUsage.touch(urlKey);
+            emit urlResolved(key, m_urls[urlKey]);
+            return;
+        }
+    }
+
+    //! configs are not shared between threads and each thread keeps its own instance
+    static thread_local int s_rulesGeneration{0};
+    KSharedConfig::Ptr rulesConfig = KSharedConfig::openConfig(QStringLiteral(RULESCONFIG));
+    const int rulesGeneration = m_rulesGeneration.load();
+
+    if (s_rulesGeneration != rulesGeneration) {
+        rulesConfig->reparseConfiguration();
+        s_rulesGeneration = rulesGeneration;
+    }
+
+    QUrl url = windowUrl(metadata, rulesConfig);
+
+    //! urls of processes that their command line is unknown are not reusable
+    if (!commandLine.isEmpty()) {
+        QMutexLocker locker(&m_urlsMutex);
+
+        if (cacheGeneration == m_cacheGeneration) {
+            insertUrl(urlKey, url);
+        }
+    }
+
+    emit urlResolved(key, url);
+}
+
+void AppDataResolver::onUrlResolved(const QString &key, const QUrl &url)
+{
+    //! icons are created only in the gui thread
+    if (!m_appData.contains(url)) {
+        m_appData[url] = appDataFromUrl(url);
+    }
+
+    AppData data = m_appData[url];
+    insertWindowUrl(key, url);
+
+    const QList<WindowId> wids = m_pendingWindows.take(key);
+
+    for (const auto &wid : wids) {
+        emit appDataResolved(wid, data);
+    }
+
+    m_saveCacheTimer.start();
+}
+
+void AppDataResolver::clearCache()
+{
+    m_appData.clear();
+    m_windowUrls.clear();
+    m_windowUrlsUsage.clear();
+
+    QMutexLocker locker(&m_urlsMutex);
+    m_urls.clear();
+    m_urlsUsage.clear();
+    m_urlsChanged = true;
+    m_cacheGeneration++;
+    m_cacheTimestamp = cacheDependenciesTimestamp();
+}
+
+void AppDataResolver::onRulesFileChanged(const QString &path)
+{
+    if (!m_rulesFiles.contains(path)) {
+        return;
+    }
+
+    m_rulesGeneration.ref();
+    clearCache();
+}
+
+QString AppDataResolver::cacheFilePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + QStringLiteral(CACHEFILE);
+}
+
+qint64 AppDataResolver::cacheDependenciesTimestamp() const
+{
+    qint64 timestamp = QFileInfo(KSycoca::absoluteFilePath()).lastModified().toMSecsSinceEpoch();
+
+    const QStringList rulesFiles = QStandardPaths::locateAll(QStandardPaths::GenericConfigLocation, QStringLiteral(RULESCONFIG));
+
+    for (const auto &file : rulesFiles) {
+        timestamp = qMax(timestamp, QFileInfo(file).lastModified().toMSecsSinceEpoch());
+    }
+
+    return timestamp;
+}
+
+void AppDataResolver::loadCache()
+{
+    QFile file(cacheFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    qint32 version{0};
+    qint64 timestamp{0};
+    in >> version >> timestamp;
+
+    if (version != CACHEVERSION || timestamp != cacheDependenciesTimestamp()) {
+        qDebug() << "Windows urls cache is outdated and it is discarded...";
+        return;
+    }
+
+    qint32 count{0};
+    in >> count;
+
+    //! urls are stored from least to most recently used
+    QList<QPair<QString, QUrl>> urls;
+
+    for (int i=0; i<count && in.status() == QDataStream::Ok; ++i) {
+        QString urlKey;
+        QUrl url;
+        in >> urlKey >> url;
+        urls << qMakePair(urlKey, url);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return;
+    }
+
+    QMutexLocker locker(&m_urlsMutex);
+
+    for (const auto &url : urls) {
+        insertUrl(url.first, url.second);
+    }
+
+    m_urlsChanged = false;
+}
+
+void AppDataResolver::saveCache()
+{
+    QList<QPair<QString, QUrl>> urls;
+    qint64 timestamp{0};
+
+    {
+        QMutexLocker locker(&m_urlsMutex);
+
+        if (!m_urlsChanged) {
+            return;
+        }
+
+        //! dependencies changed and their change has not been noticed yet,
+        //! the urls are not stored in order to not be trusted after a restart
+        if (m_cacheTimestamp != cacheDependenciesTimestamp()) {
+            return;
+        }
+
+        timestamp = m_cacheTimestamp;
+
+        for (const auto &urlKey : m_urlsUsage.keys()) {
+            urls << qMakePair(urlKey, m_urls[urlKey]);
+        }
+
+        m_urlsChanged = false;
+    }
+
+    QString filePath = cacheFilePath();
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << (qint32)CACHEVERSION << timestamp << (qint32)urls.count();
+
+    for (const auto &url : urls) {
+        out << url.first << url.second;
+    }
+
+    file.commit();
+}
+
+QUrl AppDataResolver::windowUrl(const AppMetadata &metadata, KSharedConfig::Ptr rulesConfig)
+{
+    QString desktopFile = metadata.desktopFileName;
+
+    if (!desktopFile.isEmpty()) {
+        KService::Ptr service = KService::serviceByStorageId(desktopFile);
+
+        if (service) {
+            const QString &menuId = service->menuId();
+
+            // applications: URLs are used to refer to applications by their KService::menuId
+            // (i.e. .desktop file name) rather than the absolute path to a .desktop file.
+            if (!menuId.isEmpty()) {
+                return QUrl(QStringLiteral("applications:") + menuId);
+            }
+
+            return QUrl::fromLocalFile(service->entryPath());
+        }
+
+        if (!desktopFile.endsWith(QLatin1String(".desktop"))) {
+            desktopFile.append(QLatin1String(".desktop"));
+        }
+
+        if (KDesktopFile::isDesktopFile(desktopFile) && QFile::exists(desktopFile)) {
+            return QUrl::fromLocalFile(desktopFile);
+        }
+    }
+
+    return windowUrlFromMetadata(metadata.appId, metadata.pid, rulesConfig, metadata.wmClassName);
+}
+
+}
+}
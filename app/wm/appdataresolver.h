@@ -0,0 +1,139 @@
+/*
+*  Copyright 2026  agent <agent@local>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef APPDATARESOLVER_H
+#define APPDATARESOLVER_H
+
+// local
+#include "tasktools.h"
+#include "windowinfowrap.h"
+#include "../tools/recentlyused.h"
+
+// Qt
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QUrl>
+
+// KDE
+#include <KSharedConfig>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! window properties that identify the application owning a window,
+//! they are gathered from the window system in the gui thread
+struct AppMetadata
+{
+    QString appId; // window class on X11, app id on Wayland
+    QString wmClassName; // instance name part of WM_CLASS on X11
+    QString desktopFileName;
+    quint32 pid{0};
+};
+
+//! Resolves windows application data in background threads. Resolved urls are
+//! cached based on application metadata and process command line, so windows
+//! of the same application are resolved only once. The urls cache is also stored
+//! on disk and it is discarded when the services database or the task manager
+//! rules are changed
+class AppDataResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    AppDataResolver(QObject *parent = nullptr);
+    ~AppDataResolver() override;
+
+    bool contains(const AppMetadata &metadata) const;
+    AppData appData(const AppMetadata &metadata);
+
+    //! resolved data are delivered through appDataResolved
+    void requestAppData(const WindowId &wid, const AppMetadata &metadata);
+
+    //! heavy, it goes through processes and services database
+    static QUrl windowUrl(const AppMetadata &metadata, KSharedConfig::Ptr rulesConfig);
+
+signals:
+    void appDataResolved(const WindowId &wid, const Latte::WindowSystem::AppData &data);
+
+    //! emitted from worker threads
+    void urlResolved(const QString &key, const QUrl &url);
+
+private slots:
+    void clearCache();
+    void saveCache();
+    void onRulesFileChanged(const QString &path);
+    void onUrlResolved(const QString &key, const QUrl &url);
+
+private:
+    static QString metadataKey(const AppMetadata &metadata);
+
+    void insertWindowUrl(const QString &key, const QUrl &url);
+    //! m_urlsMutex must be locked
+    void insertUrl(const QString &urlKey, const QUrl &url);
+
+    //! latest modification time of the files that affect resolved urls
+    qint64 cacheDependenciesTimestamp() const;
+    QString cacheFilePath() const;
+    void loadCache();
+
+    //! runs in worker threads
+    void resolve(const QString &key, const AppMetadata &metadata);
+
+    friend class AppDataResolveJob;
+
+private:
+    QThreadPool m_pool;
+
+    //! accessed from worker threads, keys contain the process command line so
+    //! only the most recently used ones are kept and stored on disk
+    QMutex m_urlsMutex;
+    QHash<QString, QUrl> m_urls;
+    RecentlyUsed<QString> m_urlsUsage;
+    bool m_urlsChanged{false};
+    //! increased when the cache is cleared, urls of resolutions that started
+    //! before are not cached
+    int m_cacheGeneration{0};
+    //! dependencies timestamp of the cached urls, when they were loaded or last cleared
+    qint64 m_cacheTimestamp{0};
+
+    //! increased when the task manager rules change, worker threads reparse their rules
+    QAtomicInt m_rulesGeneration{0};
+    QStringList m_rulesFiles;
+
+    QTimer m_saveCacheTimer;
+
+    //! gui thread only, application data are shared from all windows that
+    //! resolve to the same url, windows urls keys contain the process id so
+    //! only the most recently used ones are kept
+    QHash<QUrl, AppData> m_appData;
+    QHash<QString, QUrl> m_windowUrls;
+    RecentlyUsed<QString> m_windowUrlsUsage;
+    QHash<QString, QList<WindowId>> m_pendingWindows;
+};
+
+}
+}
+
+#endif
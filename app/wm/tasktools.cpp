@@ -494,6 +494,26 @@ QUrl windowUrlFromMetadata(const QString &appId, quint32 pid,
     return url;
 }
 
+QString commandLineFromPid(quint32 pid)
+{
+    if (pid == 0) {
+        return QString();
+    }
+
+#if KF5_VERSION_MINOR >= 62
+    auto proc = KProcessList::processInfo(pid);
+
+    return proc.isValid() ? proc.command() : QString();
+#else
+    KSysGuard::Processes procs;
+    procs.updateOrAddProcess(pid);
+
+    KSysGuard::Process *proc = procs.getProcess(pid);
+
+    return proc ? proc->command().simplified() : QString();
+#endif
+}
+
 KService::List servicesFromPid(quint32 pid, KSharedConfig::Ptr rulesConfig)
 {
     if (pid == 0) {
@@ -108,6 +108,15 @@ QUrl windowUrlFromMetadata(const QString &appId, quint32 pid = 0,
 KService::List servicesFromPid(quint32 pid,
     KSharedConfig::Ptr rulesConfig = KSharedConfig::Ptr());
 
+/**
+ * Returns the command line of the given process id.
+ *
+ * @param pid A process id.
+ * @returns The process command line or an empty string when the process
+ * could not be found.
+ */
+QString commandLineFromPid(quint32 pid);
+
 /**
  * Returns a list of (usually application) KService instances for the
  * given process command line and process name, by mangling the command
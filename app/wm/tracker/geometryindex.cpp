@@ -0,0 +1,224 @@
+/*
+*  Copyright 2026  agent <agent@local>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "geometryindex.h"
+
+// C++
+#include <algorithm>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+GeometryIndex::GeometryIndex()
+{
+}
+
+bool GeometryIndex::contains(const WindowHandle &wid) const
+{
+    return m_geometries.contains(wid);
+}
+
+int GeometryIndex::count() const
+{
+    return m_geometries.count();
+}
+
+int GeometryIndex::screenIndex(const QRect &geometry) const
+{
+    for (int i=0; i<m_screens.count(); ++i) {
+        if (m_screens[i].geometry == geometry) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool GeometryIndex::isRelevant(Latte::View *view, const WindowHandle &wid) const
+{
+    auto band = m_bands.constFind(view);
+
+    if (band != m_bands.constEnd() && band.value().windows.contains(wid)) {
+        return true;
+    }
+
+    int sindex = screenIndex(m_viewScreens.value(view));
+
+    return (sindex >= 0 && m_screens[sindex].windows.contains(wid));
+}
+
+void GeometryIndex::insert(const WindowHandle &wid, const QRect &geometry)
+{
+    auto previous = m_geometries.constFind(wid);
+
+    if (previous != m_geometries.constEnd() && previous.value() == geometry) {
+        return;
+    }
+
+    m_geometries[wid] = geometry;
+
+    //! moving windows rarely enter or leave a band or a screen, so sets are
+    //! touched only when the membership changes
+    for (auto &band : m_bands) {
+        if (geometry.intersects(band.area)) {
+            band.windows.insert(wid);
+        } else {
+            band.windows.remove(wid);
+        }
+    }
+
+    const QPoint center = geometry.center();
+
+    for (auto &screen : m_screens) {
+        if (screen.geometry.contains(center)) {
+            screen.windows.insert(wid);
+        } else {
+            screen.windows.remove(wid);
+        }
+    }
+}
+
+void GeometryIndex::remove(const WindowHandle &wid)
+{
+    if (!m_geometries.remove(wid)) {
+        return;
+    }
+
+    for (auto &band : m_bands) {
+        band.windows.remove(wid);
+    }
+
+    for (auto &screen : m_screens) {
+        screen.windows.remove(wid);
+    }
+}
+
+void GeometryIndex::clear()
+{
+    m_geometries.clear();
+
+    for (auto &band : m_bands) {
+        band.windows.clear();
+    }
+
+    for (auto &screen : m_screens) {
+        screen.windows.clear();
+    }
+}
+
+void GeometryIndex::retainScreen(const QRect &geometry)
+{
+    int sindex = screenIndex(geometry);
+
+    if (sindex >= 0) {
+        m_screens[sindex].views++;
+        return;
+    }
+
+    Screen screen;
+    screen.geometry = geometry;
+    screen.views = 1;
+
+    for (auto i=m_geometries.constBegin(); i!=m_geometries.constEnd(); ++i) {
+        if (geometry.contains(i.value().center())) {
+            screen.windows.insert(i.key());
+        }
+    }
+
+    m_screens << screen;
+}
+
+void GeometryIndex::releaseScreen(const QRect &geometry)
+{
+    int sindex = screenIndex(geometry);
+
+    if (sindex < 0) {
+        return;
+    }
+
+    if (--m_screens[sindex].views <= 0) {
+        m_screens.removeAt(sindex);
+    }
+}
+
+void GeometryIndex::setView(Latte::View *view, const QRect &band, const QRect &screenGeometry)
+{
+    //! views are moved or resized rarely, only then their band is rebuilt
+    auto vband = m_bands.find(view);
+
+    if (vband == m_bands.end() || vband.value().area != band) {
+        Band updated;
+        updated.area = band;
+
+        for (auto i=m_geometries.constBegin(); i!=m_geometries.constEnd(); ++i) {
+            if (i.value().intersects(band)) {
+                updated.windows.insert(i.key());
+            }
+        }
+
+        m_bands[view] = updated;
+    }
+
+    auto vscreen = m_viewScreens.constFind(view);
+
+    if (vscreen == m_viewScreens.constEnd() || vscreen.value() != screenGeometry) {
+        if (vscreen != m_viewScreens.constEnd()) {
+            releaseScreen(vscreen.value());
+        }
+
+        retainScreen(screenGeometry);
+        m_viewScreens[view] = screenGeometry;
+    }
+}
+
+void GeometryIndex::removeView(Latte::View *view)
+{
+    m_bands.remove(view);
+
+    if (m_viewScreens.contains(view)) {
+        releaseScreen(m_viewScreens.take(view));
+    }
+}
+
+QList<WindowHandle> GeometryIndex::sorted(const QSet<WindowHandle> &windows)
+{
+    QList<WindowHandle> result = windows.values();
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+QList<WindowHandle> GeometryIndex::windowsTouching(Latte::View *view) const
+{
+    auto band = m_bands.constFind(view);
+
+    return (band != m_bands.constEnd() ? sorted(band.value().windows) : QList<WindowHandle>());
+}
+
+QList<WindowHandle> GeometryIndex::windowsInScreen(Latte::View *view) const
+{
+    int sindex = screenIndex(m_viewScreens.value(view));
+
+    return (sindex >= 0 ? sorted(m_screens[sindex].windows) : QList<WindowHandle>());
+}
+
+}
+}
+}
@@ -0,0 +1,106 @@
+/*
+*  Copyright 2026  agent <agent@local>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMGEOMETRYINDEX_H
+#define WINDOWSYSTEMGEOMETRYINDEX_H
+
+// local
+#include "../windowinfowrap.h"
+
+// Qt
+#include <QHash>
+#include <QList>
+#include <QRect>
+#include <QSet>
+
+namespace Latte {
+class View;
+}
+
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Index of windows geometries against the regions that views care about. Each view
+//! registers its edge band, its geometry grown by the touch margin, and its screen.
+//! Windows are assigned to the bands they intersect and to the screen that contains
+//! their center when they are inserted, so views query only their own candidates
+//! instead of all tracked windows
+class GeometryIndex
+{
+
+public:
+    GeometryIndex();
+
+    bool contains(const WindowHandle &wid) const;
+    int count() const;
+
+    //! true when the window is a candidate for any of the view criteria
+    bool isRelevant(Latte::View *view, const WindowHandle &wid) const;
+
+    //! only the regions that the window enters or leaves are updated
+    void insert(const WindowHandle &wid, const QRect &geometry);
+    void remove(const WindowHandle &wid);
+    void clear();
+
+    //! when the view regions are unchanged nothing is updated
+    void setView(Latte::View *view, const QRect &band, const QRect &screenGeometry);
+    void removeView(Latte::View *view);
+
+    //! windows candidates sorted by their handles, touching windows intersect the
+    //! view edge band and screen windows have their center in the view screen
+    QList<WindowHandle> windowsTouching(Latte::View *view) const;
+    QList<WindowHandle> windowsInScreen(Latte::View *view) const;
+
+private:
+    struct Band
+    {
+        QRect area;
+        QSet<WindowHandle> windows;
+    };
+
+    struct Screen
+    {
+        QRect geometry;
+        int views{0};
+        QSet<WindowHandle> windows;
+    };
+
+    int screenIndex(const QRect &geometry) const;
+    void releaseScreen(const QRect &geometry);
+    void retainScreen(const QRect &geometry);
+
+    static QList<WindowHandle> sorted(const QSet<WindowHandle> &windows);
+
+private:
+    QHash<WindowHandle, QRect> m_geometries;
+
+    QHash<Latte::View *, Band> m_bands;
+    QHash<Latte::View *, QRect> m_viewScreens;
+
+    //! screens are only a few, views of the same screen share their windows list
+    QList<Screen> m_screens;
+};
+
+}
+}
+}
+
+#endif
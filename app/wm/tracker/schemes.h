@@ -24,6 +24,7 @@
 #include "../windowinfowrap.h"
 
 // Qt
+#include <QHash>
 #include <QObject>
 
 
@@ -64,7 +65,7 @@ private:
      QMap<QString, Latte::WindowSystem::SchemeColors *> m_schemes;
 
      //! window id and its corresponding scheme file
-     QMap<WindowId, QString> m_windowScheme;
+     QHash<WindowHandle, QString> m_windowScheme;
 };
 
 }
@@ -152,13 +152,55 @@ void TrackedGeneralInfo::setActiveWindow(const WindowId &wid)
     m_lastActiveWindow->setInformation(m_tracker->infoFor(wid));
 }
 
+bool TrackedGeneralInfo::requiresFullUpdate() const
+{
+    return m_requiresFullUpdate;
+}
+
+void TrackedGeneralInfo::setRequiresFullUpdate(bool required)
+{
+    m_requiresFullUpdate = required;
+}
+
+int TrackedGeneralInfo::windowHints(const WindowHandle &wid) const
+{
+    return m_hintedWindows.value(wid, NoHint);
+}
+
+void TrackedGeneralInfo::setWindowHints(const WindowHandle &wid, int hints)
+{
+    if (hints == NoHint) {
+        m_hintedWindows.remove(wid);
+    } else {
+        m_hintedWindows[wid] = hints;
+    }
+}
+
+void TrackedGeneralInfo::clearWindowHints()
+{
+    m_hintedWindows.clear();
+}
+
+const QHash<WindowHandle, int> &TrackedGeneralInfo::hintedWindows() const
+{
+    return m_hintedWindows;
+}
+
+const TrackingSnapshot &TrackedGeneralInfo::snapshot() const
+{
+    return m_snapshot;
+}
+
+void TrackedGeneralInfo::setSnapshot(const TrackingSnapshot &snapshot)
+{
+    m_snapshot = snapshot;
+}
+
 bool TrackedGeneralInfo::isTracking(const WindowInfoWrap &winfo) const
 {
-    return (winfo.isValid()
-            && isTrackingCurrentActivity()
+    return (isTrackingCurrentActivity()
             && !winfo.isMinimized()
-            && winfo.isOnDesktop(m_wm->currentDesktop())
-            && winfo.isOnActivity(m_wm->currentActivity()));
+            && m_wm->inCurrentDesktopActivity(winfo));
 }
 
 }
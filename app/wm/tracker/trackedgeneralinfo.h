@@ -22,9 +22,11 @@
 
 // local
 #include "lastactivewindow.h"
+#include "trackingsnapshot.h"
 #include "../windowinfowrap.h"
 
 // Qt
+#include <QHash>
 #include <QObject>
 
 namespace Latte {
@@ -47,6 +49,17 @@ class TrackedGeneralInfo : public QObject {
     Q_PROPERTY(Latte::WindowSystem::Tracker::LastActiveWindow *activeWindow READ lastActiveWindow NOTIFY lastActiveWindowChanged)
 
 public:
+    //! flags describing how a window relates to the tracked area
+    enum WindowHint
+    {
+        NoHint = 0x00,
+        IsActiveHint = 0x01, /*window is the active one*/
+        ActiveTrackedHint = 0x02, /*window is active inside the tracked area*/
+        MaximizedHint = 0x04, /*window is maximized inside the tracked area*/
+        TouchingHint = 0x08, /*window is touching the view*/
+        TouchingEdgeHint = 0x10 /*window is touching the view edge*/
+    };
+
     TrackedGeneralInfo(Tracker::Windows *tracker);
     ~TrackedGeneralInfo() override;
 
@@ -75,6 +88,20 @@ public:
 
     virtual bool isTracking(const WindowInfoWrap &winfo) const;
 
+    //! Incremental tracking, only windows with hints are stored
+    bool requiresFullUpdate() const;
+    void setRequiresFullUpdate(bool required);
+
+    int windowHints(const WindowHandle &wid) const;
+    void setWindowHints(const WindowHandle &wid, int hints);
+    void clearWindowHints();
+
+    const QHash<WindowHandle, int> &hintedWindows() const;
+
+    //! last published tracking state
+    const TrackingSnapshot &snapshot() const;
+    void setSnapshot(const TrackingSnapshot &snapshot);
+
 signals:
     void lastActiveWindowChanged();
 
@@ -95,8 +122,14 @@ private:
     bool m_existsWindowMaximized;
 
     bool m_isTrackingCurrentActivity{true};
+    bool m_requiresFullUpdate{true};
+
+    //! windows that are relevant to tracked area and their hints
+    QHash<WindowHandle, int> m_hintedWindows;
 
     SchemeColors *m_activeWindowScheme{nullptr};
+
+    TrackingSnapshot m_snapshot;
 };
 
 }
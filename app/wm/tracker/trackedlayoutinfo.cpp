@@ -38,6 +38,11 @@ TrackedLayoutInfo::TrackedLayoutInfo(Tracker::Windows *tracker, Latte::Layout::G
         m_activities = m_layout->appliedActivities();
         updateTrackingCurrentActivity();
     });
+
+    connect(m_layout, &Latte::Layout::GenericLayout::appliedActivitiesChanged, this, [&]() {
+        m_activities = m_layout->appliedActivities();
+        updateTrackingCurrentActivity();
+    });
 }
 
 TrackedLayoutInfo::~TrackedLayoutInfo()
@@ -0,0 +1,75 @@
+/*
+*  Copyright 2026  agent <agent@local>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trackingsnapshot.h"
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+int TrackingSnapshot::changedFields(const TrackingSnapshot &other) const
+{
+    int fields{NoField};
+
+    if (activeWindowMaximized != other.activeWindowMaximized) {
+        fields |= ActiveWindowMaximizedField;
+    }
+
+    if (activeWindowTouching != other.activeWindowTouching) {
+        fields |= ActiveWindowTouchingField;
+    }
+
+    if (activeWindowTouchingEdge != other.activeWindowTouchingEdge) {
+        fields |= ActiveWindowTouchingEdgeField;
+    }
+
+    if (existsWindowActive != other.existsWindowActive) {
+        fields |= ExistsWindowActiveField;
+    }
+
+    if (existsWindowMaximized != other.existsWindowMaximized) {
+        fields |= ExistsWindowMaximizedField;
+    }
+
+    if (existsWindowTouching != other.existsWindowTouching) {
+        fields |= ExistsWindowTouchingField;
+    }
+
+    if (existsWindowTouchingEdge != other.existsWindowTouchingEdge) {
+        fields |= ExistsWindowTouchingEdgeField;
+    }
+
+    if (isTouchingBusyVerticalView != other.isTouchingBusyVerticalView) {
+        fields |= IsTouchingBusyVerticalViewField;
+    }
+
+    if (activeWindowScheme != other.activeWindowScheme) {
+        fields |= ActiveWindowSchemeField;
+    }
+
+    if (touchingWindowScheme != other.touchingWindowScheme) {
+        fields |= TouchingWindowSchemeField;
+    }
+
+    return fields;
+}
+
+}
+}
+}
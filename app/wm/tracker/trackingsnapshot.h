@@ -0,0 +1,82 @@
+/*
+*  Copyright 2026  agent <agent@local>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMTRACKINGSNAPSHOT_H
+#define WINDOWSYSTEMTRACKINGSNAPSHOT_H
+
+// Qt
+#include <QtGlobal>
+
+namespace Latte {
+namespace WindowSystem {
+class SchemeColors;
+}
+}
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Tracking state of a view or a layout. It is published as a whole after each
+//! hints evaluation, so consumers read all values at once and are informed only
+//! for the fields that changed
+class TrackingSnapshot
+{
+public:
+    enum Field
+    {
+        NoField = 0x000,
+        ActiveWindowMaximizedField = 0x001,
+        ActiveWindowTouchingField = 0x002,
+        ActiveWindowTouchingEdgeField = 0x004,
+        ExistsWindowActiveField = 0x008,
+        ExistsWindowMaximizedField = 0x010,
+        ExistsWindowTouchingField = 0x020,
+        ExistsWindowTouchingEdgeField = 0x040,
+        IsTouchingBusyVerticalViewField = 0x080,
+        ActiveWindowSchemeField = 0x100,
+        TouchingWindowSchemeField = 0x200,
+        AllFields = 0x3FF
+    };
+
+    //! increased every time a changed snapshot is published
+    quint64 version{0};
+
+    bool activeWindowMaximized{false};
+    bool activeWindowTouching{false};
+    bool activeWindowTouchingEdge{false};
+    bool existsWindowActive{false};
+    bool existsWindowMaximized{false};
+    bool existsWindowTouching{false};
+    bool existsWindowTouchingEdge{false};
+    bool isTouchingBusyVerticalView{false};
+
+    SchemeColors *activeWindowScheme{nullptr};
+    SchemeColors *touchingWindowScheme{nullptr};
+
+    //! Functionality
+    //! fields that are different between the two snapshots, version is ignored
+    int changedFields(const TrackingSnapshot &other) const;
+};
+
+}
+}
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include "trackedlayoutinfo.h"
 #include "trackedviewinfo.h"
 #include "../abstractwindowinterface.h"
+#include "../appdataresolver.h"
 #include "../schemecolors.h"
 #include "../../apptypes.h"
 #include "../../lattecorona.h"
@@ -33,6 +34,10 @@
 #include "../../view/view.h"
 #include "../../view/positioner.h"
 
+// C++
+#include <algorithm>
+#include <iterator>
+
 namespace Latte {
 namespace WindowSystem {
 namespace Tracker {
@@ -52,6 +57,9 @@ Windows::Windows(AbstractWindowInterface *parent)
     m_updateApplicationDataTimer.setSingleShot(true);
     connect(&m_updateApplicationDataTimer, &QTimer::timeout, this, &Windows::updateApplicationData);
 
+    m_appDataResolver = new AppDataResolver(this);
+    connect(m_appDataResolver, &AppDataResolver::appDataResolved, this, &Windows::onAppDataResolved);
+
     init();
 }
 
@@ -79,20 +87,43 @@ void Windows::init()
     connect(m_wm->corona(), &Plasma::Corona::availableScreenRectChanged, this, &Windows::updateAvailableScreenGeometries);
 
     connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid) {
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
+        refreshWindow(wid, m_wm->requestInfo(wid));
+        updateHints(wid);
 
         emit windowChanged(wid);
     });
 
+    connect(m_wm, &AbstractWindowInterface::windowsChanged, this, [&](const QList<WindowId> &wids, const QList<int> &changes) {
+        QList<WindowInfoWrap> infos = m_wm->requestInfoBatch(wids);
+
+        for (int i=0; i<wids.count(); ++i) {
+            bool isTracked = m_windows.contains(wids[i]);
+            bool wasValid = isTracked && m_windows[wids[i]].isValid();
+
+            refreshWindow(wids[i], infos[i]);
+
+            //! hints do not depend on windows titles, so windows that only changed
+            //! their title do not need to be re-evaluated
+            bool onlyNameChanged = (changes[i] == AbstractWindowInterface::NameChange);
+
+            if (!onlyNameChanged || !isTracked || wasValid != infos[i].isValid()) {
+                updateHints(wids[i]);
+            }
+        }
+
+        for (const auto &wid : wids) {
+            emit windowChanged(wid);
+        }
+    });
+
     connect(m_wm, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
         m_windows.remove(wid);
 
         //! application data
-        m_initializedApplicationData.removeAll(wid);
-        m_delayedApplicationData.removeAll(wid);
+        m_initializedApplicationData.remove(wid);
+        m_delayedApplicationData.remove(wid);
 
-        updateAllHints();
+        updateHints(wid);
 
         emit windowRemoved(wid);
     });
@@ -101,21 +132,41 @@ void Windows::init()
         if (!m_windows.contains(wid)) {
             m_windows.insert(wid, m_wm->requestInfo(wid));
         }
-        updateAllHints();
+        updateHints(wid);
     });
 
     connect(m_wm, &AbstractWindowInterface::activeWindowChanged, this, [&](WindowId wid) {
         //! for some reason this is needed in order to update properly activeness values
         //! when the active window changes the previous active windows should be also updated
+        QList<WindowId> previousActiveWindows;
+
         for (const auto view : m_views.keys()) {
             WindowId lastWinId = m_views[view]->lastActiveWindow()->winId();
-            if ((lastWinId) != wid && m_windows.contains(lastWinId)) {
-                m_windows[lastWinId] = m_wm->requestInfo(lastWinId);
+            if ((lastWinId) != wid && m_windows.contains(lastWinId) && !previousActiveWindows.contains(lastWinId)) {
+                previousActiveWindows << lastWinId;
             }
         }
 
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
+        for (const auto layout : m_layouts.keys()) {
+            WindowId lastWinId = m_layouts[layout]->lastActiveWindow()->winId();
+            if ((lastWinId) != wid && m_windows.contains(lastWinId) && !previousActiveWindows.contains(lastWinId)) {
+                previousActiveWindows << lastWinId;
+            }
+        }
+
+        //! all changed windows are requested at once
+        QList<WindowId> changedWindows = previousActiveWindows;
+        changedWindows << wid;
+
+        QList<WindowInfoWrap> infos = m_wm->requestInfoBatch(changedWindows);
+
+        for (int i=0; i<changedWindows.count(); ++i) {
+            refreshWindow(changedWindows[i], infos[i]);
+        }
+
+        for (const auto &changedWid : changedWindows) {
+            updateHints(changedWid);
+        }
 
         emit activeWindowChanged(wid);
     });
@@ -141,10 +192,15 @@ void Windows::initLayoutHints(Latte::Layout::GenericLayout *layout)
         return;
     }
 
+    m_layouts[layout]->clearWindowHints();
+    m_layouts[layout]->setRequiresFullUpdate(true);
+
     setActiveWindowMaximized(layout, false);
     setExistsWindowActive(layout, false);
     setExistsWindowMaximized(layout, false);
     setActiveWindowScheme(layout, nullptr);
+
+    publishSnapshot(layout);
 }
 
 void Windows::initViewHints(Latte::View *view)
@@ -153,6 +209,9 @@ void Windows::initViewHints(Latte::View *view)
         return;
     }
 
+    m_views[view]->clearWindowHints();
+    m_views[view]->setRequiresFullUpdate(true);
+
     setActiveWindowMaximized(view, false);
     setActiveWindowTouching(view, false);
     setActiveWindowTouchingEdge(view, false);
@@ -163,6 +222,8 @@ void Windows::initViewHints(Latte::View *view)
     setIsTouchingBusyVerticalView(view, false);
     setActiveWindowScheme(view, nullptr);
     setTouchingWindowScheme(view, nullptr);
+
+    publishSnapshot(view);
 }
 
 AbstractWindowInterface *Windows::wm()
@@ -191,6 +252,16 @@ void Windows::addView(Latte::View *view)
     connect(view, &Latte::View::isTouchingBottomViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
     connect(view, &Latte::View::isTouchingTopViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
 
+    //! windows hints are evaluated incrementally, so when the view itself moves
+    //! all windows must be re-evaluated against its new geometry
+    connect(view, &Latte::View::absoluteGeometryChanged, this, [&, view]() {
+        updateHints(view);
+    });
+
+    connect(view, &Latte::View::screenGeometryChanged, this, [&, view]() {
+        updateHints(view);
+    });
+
     updateAllHints();
 
     emit informationAnnounced(view);
@@ -204,6 +275,7 @@ void Windows::removeView(Latte::View *view)
 
     m_views[view]->deleteLater();
     m_views.remove(view);
+    m_geometryIndex.removeView(view);
 
     updateRelevantLayouts();
 }
@@ -322,7 +394,6 @@ void Windows::setActiveWindowMaximized(Latte::View *view, bool activeMaximized)
     }
 
     m_views[view]->setActiveWindowMaximized(activeMaximized);
-    emit activeWindowMaximizedChanged(view);
 }
 
 bool Windows::activeWindowTouching(Latte::View *view) const
@@ -341,7 +412,6 @@ void Windows::setActiveWindowTouching(Latte::View *view, bool activeTouching)
     }
 
     m_views[view]->setActiveWindowTouching(activeTouching);
-    emit activeWindowTouchingChanged(view);
 }
 
 bool Windows::activeWindowTouchingEdge(Latte::View *view) const
@@ -360,7 +430,6 @@ void Windows::setActiveWindowTouchingEdge(Latte::View *view, bool activeTouching
     }
 
     m_views[view]->setActiveWindowTouchingEdge(activeTouchingEdge);
-    emit activeWindowTouchingEdgeChanged(view);
 }
 
 bool Windows::existsWindowActive(Latte::View *view) const
@@ -379,7 +448,6 @@ void Windows::setExistsWindowActive(Latte::View *view, bool windowActive)
     }
 
     m_views[view]->setExistsWindowActive(windowActive);
-    emit existsWindowActiveChanged(view);
 }
 
 bool Windows::existsWindowMaximized(Latte::View *view) const
@@ -398,7 +466,6 @@ void Windows::setExistsWindowMaximized(Latte::View *view, bool windowMaximized)
     }
 
     m_views[view]->setExistsWindowMaximized(windowMaximized);
-    emit existsWindowMaximizedChanged(view);
 }
 
 bool Windows::existsWindowTouching(Latte::View *view) const
@@ -417,7 +484,6 @@ void Windows::setExistsWindowTouching(Latte::View *view, bool windowTouching)
     }
 
     m_views[view]->setExistsWindowTouching(windowTouching);
-    emit existsWindowTouchingChanged(view);
 }
 
 bool Windows::existsWindowTouchingEdge(Latte::View *view) const
@@ -436,7 +502,6 @@ void Windows::setExistsWindowTouchingEdge(Latte::View *view, bool windowTouching
     }
 
     m_views[view]->setExistsWindowTouchingEdge(windowTouchingEdge);
-    emit existsWindowTouchingEdgeChanged(view);
 }
 
 
@@ -456,7 +521,6 @@ void Windows::setIsTouchingBusyVerticalView(Latte::View *view, bool viewTouching
     }
 
     m_views[view]->setIsTouchingBusyVerticalView(viewTouching);
-    emit isTouchingBusyVerticalViewChanged(view);
 }
 
 SchemeColors *Windows::activeWindowScheme(Latte::View *view) const
@@ -475,7 +539,6 @@ void Windows::setActiveWindowScheme(Latte::View *view, WindowSystem::SchemeColor
     }
 
     m_views[view]->setActiveWindowScheme(scheme);
-    emit activeWindowSchemeChanged(view);
 }
 
 SchemeColors *Windows::touchingWindowScheme(Latte::View *view) const
@@ -494,7 +557,6 @@ void Windows::setTouchingWindowScheme(Latte::View *view, WindowSystem::SchemeCol
     }
 
     m_views[view]->setTouchingWindowScheme(scheme);
-    emit touchingWindowSchemeChanged(view);
 }
 
 LastActiveWindow *Windows::lastActiveWindow(Latte::View *view)
@@ -506,6 +568,47 @@ LastActiveWindow *Windows::lastActiveWindow(Latte::View *view)
     return m_views[view]->lastActiveWindow();
 }
 
+TrackingSnapshot Windows::snapshot(Latte::View *view) const
+{
+    if (!m_views.contains(view)) {
+        return TrackingSnapshot();
+    }
+
+    return m_views[view]->snapshot();
+}
+
+void Windows::publishSnapshot(Latte::View *view)
+{
+    if (!m_views.contains(view)) {
+        return;
+    }
+
+    TrackedViewInfo *vinfo = m_views[view];
+
+    TrackingSnapshot snapshot;
+    snapshot.activeWindowMaximized = vinfo->activeWindowMaximized();
+    snapshot.activeWindowTouching = vinfo->activeWindowTouching();
+    snapshot.activeWindowTouchingEdge = vinfo->activeWindowTouchingEdge();
+    snapshot.existsWindowActive = vinfo->existsWindowActive();
+    snapshot.existsWindowMaximized = vinfo->existsWindowMaximized();
+    snapshot.existsWindowTouching = vinfo->existsWindowTouching();
+    snapshot.existsWindowTouchingEdge = vinfo->existsWindowTouchingEdge();
+    snapshot.isTouchingBusyVerticalView = vinfo->isTouchingBusyVerticalView();
+    snapshot.activeWindowScheme = vinfo->activeWindowScheme();
+    snapshot.touchingWindowScheme = vinfo->touchingWindowScheme();
+
+    int changedFields = snapshot.changedFields(vinfo->snapshot());
+
+    if (changedFields == TrackingSnapshot::NoField) {
+        return;
+    }
+
+    snapshot.version = vinfo->snapshot().version + 1;
+    vinfo->setSnapshot(snapshot);
+
+    emit snapshotChanged(view, changedFields);
+}
+
 //! Layouts
 bool Windows::enabled(Latte::Layout::GenericLayout *layout)
 {
@@ -532,7 +635,6 @@ void Windows::setActiveWindowMaximized(Latte::Layout::GenericLayout *layout, boo
     }
 
     m_layouts[layout]->setActiveWindowMaximized(activeMaximized);
-    emit activeWindowMaximizedChangedForLayout(layout);
 }
 
 bool Windows::existsWindowActive(Latte::Layout::GenericLayout *layout) const
@@ -551,7 +653,6 @@ void Windows::setExistsWindowActive(Latte::Layout::GenericLayout *layout, bool w
     }
 
     m_layouts[layout]->setExistsWindowActive(windowActive);
-    emit existsWindowActiveChangedForLayout(layout);
 }
 
 bool Windows::existsWindowMaximized(Latte::Layout::GenericLayout *layout) const
@@ -570,7 +671,6 @@ void Windows::setExistsWindowMaximized(Latte::Layout::GenericLayout *layout, boo
     }
 
     m_layouts[layout]->setExistsWindowMaximized(windowMaximized);
-    emit existsWindowMaximizedChangedForLayout(layout);
 }
 
 SchemeColors *Windows::activeWindowScheme(Latte::Layout::GenericLayout *layout) const
@@ -589,7 +689,6 @@ void Windows::setActiveWindowScheme(Latte::Layout::GenericLayout *layout, Window
     }
 
     m_layouts[layout]->setActiveWindowScheme(scheme);
-    emit activeWindowSchemeChangedForLayout(layout);
 }
 
 LastActiveWindow *Windows::lastActiveWindow(Latte::Layout::GenericLayout *layout)
@@ -601,6 +700,42 @@ LastActiveWindow *Windows::lastActiveWindow(Latte::Layout::GenericLayout *layout
     return m_layouts[layout]->lastActiveWindow();
 }
 
+TrackingSnapshot Windows::snapshot(Latte::Layout::GenericLayout *layout) const
+{
+    if (!m_layouts.contains(layout)) {
+        return TrackingSnapshot();
+    }
+
+    return m_layouts[layout]->snapshot();
+}
+
+void Windows::publishSnapshot(Latte::Layout::GenericLayout *layout)
+{
+    if (!m_layouts.contains(layout)) {
+        return;
+    }
+
+    TrackedLayoutInfo *linfo = m_layouts[layout];
+
+    //! layouts are tracked only for active and maximized windows
+    TrackingSnapshot snapshot;
+    snapshot.activeWindowMaximized = linfo->activeWindowMaximized();
+    snapshot.existsWindowActive = linfo->existsWindowActive();
+    snapshot.existsWindowMaximized = linfo->existsWindowMaximized();
+    snapshot.activeWindowScheme = linfo->activeWindowScheme();
+
+    int changedFields = snapshot.changedFields(linfo->snapshot());
+
+    if (changedFields == TrackingSnapshot::NoField) {
+        return;
+    }
+
+    snapshot.version = linfo->snapshot().version + 1;
+    linfo->setSnapshot(snapshot);
+
+    emit snapshotChangedForLayout(layout, changedFields);
+}
+
 
 //! Windows
 bool Windows::isValidFor(const WindowId &wid) const
@@ -612,23 +747,55 @@ bool Windows::isValidFor(const WindowId &wid) const
     return m_windows[wid].isValid();
 }
 
-QIcon Windows::iconFor(const WindowId &wid)
+bool Windows::resolveApplicationData(const WindowId &wid)
+{
+    AppMetadata metadata = m_wm->appMetadataFor(wid);
+
+    if (m_appDataResolver->contains(metadata)) {
+        setApplicationData(wid, m_appDataResolver->appData(metadata));
+        return true;
+    }
+
+    m_appDataResolver->requestAppData(wid, metadata);
+    return false;
+}
+
+void Windows::setApplicationData(const WindowId &wid, const AppData &data)
 {
     if (!m_windows.contains(wid)) {
-        return QIcon();
+        return;
     }
 
-    if (m_windows[wid].icon().isNull()) {
-        AppData data = m_wm->appDataFor(wid);
+    QIcon icon = data.icon;
 
-        QIcon icon = data.icon;
+    if (icon.isNull()) {
+        icon = m_wm->iconFor(wid);
+    }
 
-        if (icon.isNull()) {
-            icon = m_wm->iconFor(wid);
-        }
+    m_windows[wid].setIcon(icon);
+    m_windows[wid].setAppName(data.name);
+}
+
+void Windows::onAppDataResolved(const WindowId &wid, const AppData &data)
+{
+    if (!m_windows.contains(wid)) {
+        return;
+    }
+
+    setApplicationData(wid, data);
+
+    emit applicationDataChanged(wid);
+}
+
+QIcon Windows::iconFor(const WindowId &wid)
+{
+    if (!m_windows.contains(wid)) {
+        return QIcon();
+    }
 
-        m_windows[wid].setIcon(icon);
-        return icon;
+    if (m_windows[wid].icon().isNull() && !resolveApplicationData(wid)) {
+        //! until application data are resolved the window icon is used
+        return m_wm->iconFor(wid);
     }
 
     return m_windows[wid].icon();
@@ -641,42 +808,50 @@ QString Windows::appNameFor(const WindowId &wid)
     }
 
     if(!m_initializedApplicationData.contains(wid) && !m_delayedApplicationData.contains(wid)) {
-        m_delayedApplicationData.append(wid);
+        m_delayedApplicationData.insert(wid);
         m_updateApplicationDataTimer.start();
     }
 
     if (m_windows[wid].appName().isEmpty()) {
-        AppData data = m_wm->appDataFor(wid);
-
-        m_windows[wid].setAppName(data.name);
-
-        return data.name;
+        resolveApplicationData(wid);
     }
 
     return m_windows[wid].appName();
 }
 
-void Windows::updateApplicationData()
+void Windows::refreshWindow(const WindowId &wid, WindowInfoWrap winfo)
 {
-    if (m_delayedApplicationData.count() > 0) {
-        for(int i=0; i<m_delayedApplicationData.count(); ++i) {
-            auto wid = m_delayedApplicationData[i];
+    auto current = m_windows.constFind(wid);
 
-            if (m_windows.contains(wid)) {
-                AppData data = m_wm->appDataFor(wid);
+    //! application name and icon are resolved lazily, so they are kept
+    //! when the window information is refreshed from the window manager
+    if (current != m_windows.constEnd()) {
+        if (winfo.appName().isEmpty() && !current.value().appName().isEmpty()) {
+            winfo.setAppName(current.value().appName());
+        }
 
-                QIcon icon = data.icon;
+        if (winfo.icon().isNull() && !current.value().icon().isNull()) {
+            winfo.setIcon(current.value().icon());
+        }
+    }
 
-                if (icon.isNull()) {
-                    icon = m_wm->iconFor(wid);
-                }
+    m_windows[wid] = winfo;
+}
 
-                m_windows[wid].setIcon(icon);
-                m_windows[wid].setAppName(data.name);
+void Windows::updateApplicationData()
+{
+    if (m_delayedApplicationData.count() > 0) {
+        for(const auto &handle : m_delayedApplicationData) {
+            auto winfo = m_windows.constFind(handle);
 
-                m_initializedApplicationData.append(wid);
+            if (winfo != m_windows.constEnd()) {
+                const WindowId wid = winfo.value().wid();
+                m_initializedApplicationData.insert(handle);
 
-                emit applicationDataChanged(wid);
+                //! when data are not available yet, applicationDataChanged is sent after they are resolved
+                if (resolveApplicationData(wid)) {
+                    emit applicationDataChanged(wid);
+                }
             }
         }
     }
@@ -696,6 +871,75 @@ WindowInfoWrap Windows::infoFor(const WindowId &wid) const
 
 
 //! Windows Criteria Functions
+int Windows::windowHints(Latte::View *view, const WindowInfoWrap &winfo)
+{
+    if (!m_wm->inCurrentDesktopActivity(winfo)
+            || m_wm->hasBlockedTracking(winfo.wid())
+            || winfo.isMinimized()) {
+        return TrackedGeneralInfo::NoHint;
+    }
+
+    int hints{TrackedGeneralInfo::NoHint};
+
+    if (isActiveInViewScreen(view, winfo)) {
+        hints |= TrackedGeneralInfo::ActiveTrackedHint;
+    }
+
+    if (isMaximizedInViewScreen(view, winfo)) {
+        hints |= TrackedGeneralInfo::MaximizedHint;
+    }
+
+    if (isTouchingView(view, winfo)) {
+        hints |= TrackedGeneralInfo::TouchingHint;
+    }
+
+    if (isTouchingViewEdge(view, winfo)) {
+        hints |= TrackedGeneralInfo::TouchingEdgeHint;
+    }
+
+    //! windows that are only active are irrelevant for the view
+    if (hints != TrackedGeneralInfo::NoHint && winfo.isActive()) {
+        hints |= TrackedGeneralInfo::IsActiveHint;
+    }
+
+    return hints;
+}
+
+int Windows::windowHints(Latte::Layout::GenericLayout *layout, const WindowInfoWrap &winfo)
+{
+    Q_UNUSED(layout)
+
+    if (!m_wm->inCurrentDesktopActivity(winfo)
+            || m_wm->hasBlockedTracking(winfo.wid())
+            || winfo.isMinimized()) {
+        return TrackedGeneralInfo::NoHint;
+    }
+
+    int hints{TrackedGeneralInfo::NoHint};
+
+    if (isActive(winfo)) {
+        hints |= (TrackedGeneralInfo::IsActiveHint | TrackedGeneralInfo::ActiveTrackedHint);
+    }
+
+    if (winfo.isMaximized()) {
+        hints |= TrackedGeneralInfo::MaximizedHint;
+    }
+
+    return hints;
+}
+
+bool Windows::isFaultyWindow(const WindowInfoWrap &winfo) const
+{
+    return (winfo.handle().isNull() || winfo.geometry() == QRect(0, 0, 0, 0));
+}
+
+void Windows::updateViewRegions(Latte::View *view)
+{
+    //! windows can touch a view only when they intersect its geometry including its
+    //! edge neighborhood, active and maximized windows are searched in the view screen
+    m_geometryIndex.setView(view, view->absoluteGeometry().adjusted(-1, -1, 1, 1), view->screenGeometry());
+}
+
 bool Windows::intersects(Latte::View *view, const WindowInfoWrap &winfo)
 {
     return (!winfo.isMinimized() && !winfo.isShaded() && winfo.geometry().intersects(view->absoluteGeometry()));
@@ -790,9 +1034,10 @@ void Windows::cleanupFaultyWindows()
         auto winfo = m_windows[key];
 
         //! garbage windows removing
-        if (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0)) {
+        if (isFaultyWindow(winfo)) {
             //qDebug() << "Faulty Geometry ::: " << winfo.wid();
             m_windows.remove(key);
+            m_geometryIndex.remove(key);
         }
     }
 }
@@ -830,6 +1075,77 @@ void Windows::updateAllHints()
     }
 }
 
+void Windows::updateHints(const WindowId &wid)
+{
+    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
+    //! such windows are dropped immediately
+    if (m_windows.contains(wid) && isFaultyWindow(m_windows[wid])) {
+        m_windows.remove(wid);
+    }
+
+    bool exists = m_windows.contains(wid);
+
+    if (exists && m_windows[wid].isValid()) {
+        m_geometryIndex.insert(wid, m_windows[wid].geometry());
+    } else {
+        m_geometryIndex.remove(wid);
+    }
+
+    for (const auto view : m_views.keys()) {
+        TrackedViewInfo *vinfo = m_views[view];
+
+        if (!vinfo->enabled() || !vinfo->isTrackingCurrentActivity()) {
+            vinfo->setRequiresFullUpdate(true);
+            continue;
+        }
+
+        if (vinfo->requiresFullUpdate()) {
+            updateHints(view);
+            continue;
+        }
+
+        int previousHints = vinfo->windowHints(wid);
+
+        //! same as the full update, only windows that are present in the view screen
+        //! or its edge band can affect its hints
+        bool isRelevant = exists && m_geometryIndex.isRelevant(view, wid);
+        int hints = isRelevant ? windowHints(view, m_windows[wid]) : TrackedGeneralInfo::NoHint;
+
+        //! hinted windows are always re-evaluated because their information
+        //! e.g. title or scheme, is used from the view
+        if (previousHints != hints || hints != TrackedGeneralInfo::NoHint) {
+            vinfo->setWindowHints(wid, hints);
+            evaluateHints(view);
+        }
+    }
+
+    for (const auto layout : m_layouts.keys()) {
+        TrackedLayoutInfo *linfo = m_layouts[layout];
+
+        if (!linfo->enabled() || !linfo->isTrackingCurrentActivity()) {
+            linfo->setRequiresFullUpdate(true);
+            continue;
+        }
+
+        if (linfo->requiresFullUpdate()) {
+            updateHints(layout);
+            continue;
+        }
+
+        int previousHints = linfo->windowHints(wid);
+        int hints = exists ? windowHints(layout, m_windows[wid]) : TrackedGeneralInfo::NoHint;
+
+        if (previousHints != hints || hints != TrackedGeneralInfo::NoHint) {
+            linfo->setWindowHints(wid, hints);
+            evaluateHints(layout);
+        }
+    }
+
+    if (!m_extraViewHintsTimer.isActive()) {
+        m_extraViewHintsTimer.start();
+    }
+}
+
 void Windows::updateExtraViewHints()
 {
     for (const auto horView : m_views.keys()) {
@@ -863,17 +1179,60 @@ void Windows::updateExtraViewHints()
             //qDebug() << " Touching Busy Vertical View :: " << horView->location() << " - " << horView->positioner()->currentScreenId() << " :: " << touchingBusyVerticalView;
 
             setIsTouchingBusyVerticalView(horView, touchingBusyVerticalView);
+            publishSnapshot(horView);
         }
     }
 }
 
 void Windows::updateHints(Latte::View *view)
 {
-    if (!m_views.contains(view) || !m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
+    if (!m_views.contains(view)) {
+        return;
+    }
+
+    TrackedViewInfo *vinfo = m_views[view];
+
+    if (!vinfo->enabled() || !vinfo->isTrackingCurrentActivity()) {
+        vinfo->setRequiresFullUpdate(true);
+        return;
+    }
+
+    vinfo->clearWindowHints();
+    updateViewRegions(view);
+
+    //qDebug() << " -- TRACKING REPORT (SCREEN)--";
+
+    //! faulty windows are already dropped when they are updated and only windows
+    //! that are present in the view screen or its edge band can affect its hints
+    const QList<WindowHandle> screenWindows = m_geometryIndex.windowsInScreen(view);
+    const QList<WindowHandle> touchingWindows = m_geometryIndex.windowsTouching(view);
+
+    QList<WindowHandle> candidates;
+    candidates.reserve(screenWindows.count() + touchingWindows.count());
+    std::set_union(screenWindows.constBegin(), screenWindows.constEnd(),
+                   touchingWindows.constBegin(), touchingWindows.constEnd(),
+                   std::back_inserter(candidates));
+
+    for (const auto &handle : candidates) {
+        const WindowInfoWrap &winfo = m_windows[handle];
+
+        //qDebug() << " _ _ _ ";
+        //qDebug() << "TRACKING | WINDOW INFO :: " << winfo.wid() << " _ " << winfo.appName() << " _ " << winfo.geometry() << " _ " << winfo.display();
+
+        vinfo->setWindowHints(winfo.wid(), windowHints(view, winfo));
+    }
+
+    vinfo->setRequiresFullUpdate(false);
+
+    evaluateHints(view);
+}
+
+void Windows::evaluateHints(Latte::View *view)
+{
+    if (!m_views.contains(view)) {
         return;
     }
 
-    bool foundActive{false};
     bool foundActiveInCurScreen{false};
     bool foundActiveTouchInCurScreen{false};
     bool foundActiveEdgeTouchInCurScreen{false};
@@ -883,10 +1242,6 @@ void Windows::updateHints(Latte::View *view)
 
     bool foundActiveGroupTouchInCurScreen{false};
 
-    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
-    //! maybe a garbage collector here is a good idea!!!
-    bool existsFaultyWindow{false};
-
     WindowId maxWinId;
     WindowId activeWinId;
     WindowId touchWinId;
@@ -894,108 +1249,84 @@ void Windows::updateHints(Latte::View *view)
     WindowId activeTouchWinId;
     WindowId activeTouchEdgeWinId;
 
-    //qDebug() << " -- TRACKING REPORT (SCREEN)--";
+    const QHash<WindowHandle, int> &hintedWindows = m_views[view]->hintedWindows();
 
-    //! First Pass
-    for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
-            existsFaultyWindow = true;
-        }
+    //! windows are visited in handles order, so when many windows are maximized or
+    //! touching the view the chosen one does not depend on the hash iteration order
+    QList<WindowHandle> hintedHandles = hintedWindows.keys();
+    std::sort(hintedHandles.begin(), hintedHandles.end());
 
-        if ( !m_wm->inCurrentDesktopActivity(winfo)
-             || m_wm->hasBlockedTracking(winfo.wid())
-             || winfo.isMinimized()) {
+    //! First Pass, only windows that are relevant to the view are checked
+    for (const auto &handle : hintedHandles) {
+        auto winfo = m_windows.constFind(handle);
+
+        if (winfo == m_windows.constEnd()) {
             continue;
         }
 
-        //qDebug() << " _ _ _ ";
-        //qDebug() << "TRACKING | WINDOW INFO :: " << winfo.wid() << " _ " << winfo.appName() << " _ " << winfo.geometry() << " _ " << winfo.display();
-
-        if (isActive(winfo)) {
-            foundActive = true;
-        }
+        const WindowId wid = winfo.value().wid();
+        int hints = hintedWindows.value(handle);
+        bool isActiveWindow = (hints & TrackedGeneralInfo::IsActiveHint);
 
-        if (isActiveInViewScreen(view, winfo)) {
+        if (hints & TrackedGeneralInfo::ActiveTrackedHint) {
             foundActiveInCurScreen = true;
-            activeWinId = winfo.wid();
+            activeWinId = wid;
         }
 
         //! Maximized windows flags
-        if ((winfo.isActive() && isMaximizedInViewScreen(view, winfo)) //! active maximized windows have higher priority than the rest maximized windows
-                || (!foundMaximizedInCurScreen && isMaximizedInViewScreen(view, winfo))) {
+        if ((hints & TrackedGeneralInfo::MaximizedHint)
+                && (isActiveWindow || !foundMaximizedInCurScreen)) { //! active maximized windows have higher priority than the rest maximized windows
             foundMaximizedInCurScreen = true;
-            maxWinId = winfo.wid();
+            maxWinId = wid;
         }
 
         //! Touching windows flags
-
-        bool touchingViewEdge = isTouchingViewEdge(view, winfo);
-        bool touchingView =  isTouchingView(view, winfo);
-
-        if (touchingView) {
-            if (winfo.isActive()) {
+        if (hints & TrackedGeneralInfo::TouchingHint) {
+            if (isActiveWindow) {
                 foundActiveTouchInCurScreen = true;
-                activeTouchWinId = winfo.wid();
+                activeTouchWinId = wid;
             } else {
                 foundTouchInCurScreen = true;
-                touchWinId = winfo.wid();
+                touchWinId = wid;
             }
         }
 
-        if (touchingViewEdge) {
-            if (winfo.isActive()) {
+        if (hints & TrackedGeneralInfo::TouchingEdgeHint) {
+            if (isActiveWindow) {
                 foundActiveEdgeTouchInCurScreen = true;
-                activeTouchEdgeWinId = winfo.wid();
+                activeTouchEdgeWinId = wid;
             } else {
                 foundTouchEdgeInCurScreen = true;
-                touchEdgeWinId = winfo.wid();
+                touchEdgeWinId = wid;
             }
         }
 
-        //qDebug() << "TRACKING |       ACTIVE:"<< foundActive <<  " ACT_CUR_SCR:" << foundTouchInCurScreen << " MAXIM:"<<foundMaximizedInCurScreen;
-        //qDebug() << "TRACKING |       TOUCHING VIEW EDGE:"<< touchingViewEdge << " TOUCHING VIEW:" << foundTouchInCurScreen;
-    }
-
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
+        //qDebug() << "TRACKING |       ACTIVE_CUR_SCR:" << foundActiveInCurScreen << " TOUCH_CUR_SCR:" << foundTouchInCurScreen << " MAXIM:"<<foundMaximizedInCurScreen;
     }
 
     //! PASS 2
     if (foundActiveInCurScreen && !foundActiveTouchInCurScreen) {
-        //! Second Pass to track also Child windows if needed
-
-        //qDebug() << "Windows Array...";
-        //for (const auto &winfo : m_windows) {
-        //    qDebug() << " - " << winfo.wid() << " - " << winfo.isValid() << " - " << winfo.display() << " - " << winfo.geometry() << " parent : " << winfo.parentId();
-        //}
-        //qDebug() << " - - - - - ";
-
-        WindowInfoWrap activeInfo = m_windows[activeWinId];
-        WindowId mainWindowId = activeInfo.isChildWindow() ? activeInfo.parentId() : activeWinId;
+        //! Second Pass to track also Child windows if needed,
+        //! only windows touching the view can change the result
+        WindowInfoWrap activeInfo = m_windows.value(activeWinId);
+        WindowHandle mainWindow = activeInfo.isChildWindow() ? activeInfo.parentHandle() : WindowHandle(activeWinId);
 
-        for (const auto &winfo : m_windows) {
-            if (!m_wm->inCurrentDesktopActivity(winfo)
-                    || m_wm->hasBlockedTracking(winfo.wid())
-                    || winfo.isMinimized()) {
+        for (QHash<WindowHandle, int>::const_iterator i=hintedWindows.constBegin(); i!=hintedWindows.constEnd(); ++i) {
+            if (!(i.value() & TrackedGeneralInfo::TouchingHint)) {
                 continue;
             }
 
-            bool inActiveGroup = (winfo.wid() == mainWindowId || winfo.parentId() == mainWindowId);
-
             //! consider only windows that belong to active window group meaning the main window
             //! and its children
-            if (!inActiveGroup) {
-                continue;
-            }
+            bool inActiveGroup = (i.key() == mainWindow || m_windows.value(i.key()).parentHandle() == mainWindow);
 
-            if (isTouchingView(view, winfo)) {
+            if (inActiveGroup) {
                 foundActiveGroupTouchInCurScreen = true;
                 break;
             }
         }
     }
 
-
     //! HACK: KWin Effects such as ShowDesktop have no way to be identified and as such
     //! create issues with identifying properly touching and maximized windows. BUT when
     //! they are enabled then NO ACTIVE window is found. This is a way to identify these
@@ -1032,6 +1363,8 @@ void Windows::updateHints(Latte::View *view)
         setTouchingWindowScheme(view, nullptr);
     }
 
+    publishSnapshot(view);
+
     //! update LastActiveWindow
     if (foundActiveInCurScreen) {
         m_views[view]->setActiveWindow(activeWinId);
@@ -1048,52 +1381,87 @@ void Windows::updateHints(Latte::View *view)
 }
 
 void Windows::updateHints(Latte::Layout::GenericLayout *layout) {
-    if (!m_layouts.contains(layout) || !m_layouts[layout]->enabled() || !m_layouts[layout]->isTrackingCurrentActivity()) {
+    if (!m_layouts.contains(layout)) {
         return;
     }
 
-    bool foundActive{false};
-    bool foundActiveMaximized{false};
-    bool foundMaximized{false};
+    TrackedLayoutInfo *linfo = m_layouts[layout];
+
+    if (!linfo->enabled() || !linfo->isTrackingCurrentActivity()) {
+        linfo->setRequiresFullUpdate(true);
+        return;
+    }
 
     //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
     //! maybe a garbage collector here is a good idea!!!
     bool existsFaultyWindow{false};
 
-    WindowId activeWinId;
-    WindowId maxWinId;
+    linfo->clearWindowHints();
 
     for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
+        if (!existsFaultyWindow && isFaultyWindow(winfo)) {
             existsFaultyWindow = true;
         }
 
-        if (!m_wm->inCurrentDesktopActivity(winfo)
-                || m_wm->hasBlockedTracking(winfo.wid())
-                || winfo.isMinimized()) {
+        linfo->setWindowHints(winfo.wid(), windowHints(layout, winfo));
+
+        //qDebug() << "window geometry ::: " << winfo.geometry();
+    }
+
+    if (existsFaultyWindow) {
+        cleanupFaultyWindows();
+
+        for (const auto &wid : linfo->hintedWindows().keys()) {
+            if (!m_windows.contains(wid)) {
+                linfo->setWindowHints(wid, TrackedGeneralInfo::NoHint);
+            }
+        }
+    }
+
+    linfo->setRequiresFullUpdate(false);
+
+    evaluateHints(layout);
+}
+
+void Windows::evaluateHints(Latte::Layout::GenericLayout *layout)
+{
+    if (!m_layouts.contains(layout)) {
+        return;
+    }
+
+    bool foundActive{false};
+    bool foundActiveMaximized{false};
+    bool foundMaximized{false};
+
+    WindowId activeWinId;
+    WindowId maxWinId;
+
+    const QHash<WindowHandle, int> &hintedWindows = m_layouts[layout]->hintedWindows();
+
+    for (QHash<WindowHandle, int>::const_iterator i=hintedWindows.constBegin(); i!=hintedWindows.constEnd(); ++i) {
+        auto winfo = m_windows.constFind(i.key());
+
+        if (winfo == m_windows.constEnd()) {
             continue;
         }
 
-        if (isActive(winfo)) {
+        const WindowId wid = winfo.value().wid();
+        int hints = i.value();
+
+        if (hints & TrackedGeneralInfo::ActiveTrackedHint) {
             foundActive = true;
-            activeWinId = winfo.wid();
+            activeWinId = wid;
 
-            if (winfo.isMaximized() && !winfo.isMinimized()) {
+            if (hints & TrackedGeneralInfo::MaximizedHint) {
                 foundActiveMaximized = true;
-                maxWinId = winfo.wid();
+                maxWinId = wid;
             }
         }
 
-        if (!foundActiveMaximized && winfo.isMaximized() && !winfo.isMinimized()) {
+        if (!foundActiveMaximized && (hints & TrackedGeneralInfo::MaximizedHint)) {
             foundMaximized = true;
-            maxWinId = winfo.wid();
+            maxWinId = wid;
         }
-
-        //qDebug() << "window geometry ::: " << winfo.geometry();
-    }
-
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
     }
 
     //! HACK: KWin Effects such as ShowDesktop have no way to be identified and as such
@@ -1114,6 +1482,8 @@ void Windows::updateHints(Latte::Layout::GenericLayout *layout) {
     //! update color schemes for active and touching windows
     setActiveWindowScheme(layout, (foundActive ? m_wm->schemesTracker()->schemeForWindow(activeWinId) : nullptr));
 
+    publishSnapshot(layout);
+
     //! update LastActiveWindow
     if (foundActive) {
         m_layouts[layout]->setActiveWindow(activeWinId);
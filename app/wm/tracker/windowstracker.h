@@ -22,6 +22,8 @@
 
 // local
 #include <coretypes.h>
+#include "geometryindex.h"
+#include "trackingsnapshot.h"
 #include "../windowinfowrap.h"
 
 // Qt
@@ -29,6 +31,7 @@
 
 #include <QHash>
 #include <QMap>
+#include <QSet>
 #include <QTimer>
 
 
@@ -39,6 +42,7 @@ class GenericLayout;
 }
 namespace WindowSystem {
 class AbstractWindowInterface;
+class AppDataResolver;
 class SchemeColors;
 namespace Tracker {
 class LastActiveWindow;
@@ -78,6 +82,8 @@ public:
     SchemeColors *touchingWindowScheme(Latte::View *view) const;
     LastActiveWindow *lastActiveWindow(Latte::View *view);
 
+    TrackingSnapshot snapshot(Latte::View *view) const;
+
     //! Layouts Tracking (all screens)
     bool enabled(Latte::Layout::GenericLayout *layout);
     bool activeWindowMaximized(Latte::Layout::GenericLayout *layout) const;
@@ -86,6 +92,8 @@ public:
     SchemeColors *activeWindowScheme(Latte::Layout::GenericLayout *layout) const;
     LastActiveWindow *lastActiveWindow(Latte::Layout::GenericLayout *layout);
 
+    TrackingSnapshot snapshot(Latte::Layout::GenericLayout *layout) const;
+
     //! Windows management
     bool isValidFor(const WindowId &wid) const;
     QIcon iconFor(const WindowId &wid);
@@ -97,24 +105,13 @@ public:
 signals:
     //! Views
     void enabledChanged(const Latte::View *view);
-    void activeWindowMaximizedChanged(const Latte::View *view);
-    void activeWindowTouchingChanged(const Latte::View *view);
-    void activeWindowTouchingEdgeChanged(const Latte::View *view);
-    void existsWindowActiveChanged(const Latte::View *view);
-    void existsWindowMaximizedChanged(const Latte::View *view);
-    void existsWindowTouchingChanged(const Latte::View *view);
-    void existsWindowTouchingEdgeChanged(const Latte::View *view);
-    void isTouchingBusyVerticalViewChanged(const Latte::View *view);
-    void activeWindowSchemeChanged(const Latte::View *view);
-    void touchingWindowSchemeChanged(const Latte::View *view);
+    //! changedFields are TrackingSnapshot::Field flags
+    void snapshotChanged(const Latte::View *view, int changedFields);
     void informationAnnounced(const Latte::View *view);
 
     //! Layouts
     void enabledChangedForLayout(const Latte::Layout::GenericLayout *layout);
-    void activeWindowMaximizedChangedForLayout(const Latte::Layout::GenericLayout *layout);
-    void existsWindowActiveChangedForLayout(const Latte::Layout::GenericLayout *layout);
-    void existsWindowMaximizedChangedForLayout(const Latte::Layout::GenericLayout *layout);
-    void activeWindowSchemeChangedForLayout(const Latte::Layout::GenericLayout *layout);
+    void snapshotChangedForLayout(const Latte::Layout::GenericLayout *layout, int changedFields);
     void informationAnnouncedForLayout(const Latte::Layout::GenericLayout *layout);
 
     //! overloading WM signals in order to update first m_windows and afterwards
@@ -132,6 +129,7 @@ private slots:
 
     void updateApplicationData();
     void updateRelevantLayouts();
+    void onAppDataResolved(const WindowId &wid, const Latte::WindowSystem::AppData &data);
     void updateExtraViewHints();
 
 private:
@@ -142,10 +140,20 @@ private:
 
     void updateAllHints();
 
+    //! incremental update, only the provided window is re-evaluated
+    void updateHints(const WindowId &wid);
+
     //! Views
     void updateHints(Latte::View *view);
     void updateHints(Latte::Layout::GenericLayout *layout);
 
+    void evaluateHints(Latte::View *view);
+    void evaluateHints(Latte::Layout::GenericLayout *layout);
+
+    //! publish current tracking state and inform consumers for the changed fields
+    void publishSnapshot(Latte::View *view);
+    void publishSnapshot(Latte::Layout::GenericLayout *layout);
+
     void setActiveWindowMaximized(Latte::View *view, bool activeMaximized);
     void setActiveWindowTouching(Latte::View *view, bool activeTouching);
     void setActiveWindowTouchingEdge(Latte::View *view, bool activeTouchingEdge);
@@ -164,6 +172,19 @@ private:
     void setActiveWindowScheme(Latte::Layout::GenericLayout *layout, WindowSystem::SchemeColors *scheme);
 
     //! Windows
+    //! stores window information that was requested from the window manager
+    void refreshWindow(const WindowId &wid, WindowInfoWrap winfo);
+
+    //! returns true when application data were already available and they
+    //! are applied immediately, otherwise they are resolved asynchronously
+    bool resolveApplicationData(const WindowId &wid);
+    void setApplicationData(const WindowId &wid, const AppData &data);
+
+    int windowHints(Latte::View *view, const WindowInfoWrap &winfo);
+    int windowHints(Latte::Layout::GenericLayout *layout, const WindowInfoWrap &winfo);
+
+    bool isFaultyWindow(const WindowInfoWrap &winfo) const;
+    void updateViewRegions(Latte::View *view);
     bool intersects(Latte::View *view, const WindowInfoWrap &winfo);
     bool isActive(const WindowInfoWrap &winfo);
     bool isActiveInViewScreen(Latte::View *view, const WindowInfoWrap &winfo);
@@ -194,14 +215,21 @@ private:
         Latte::Types::SidebarAutoHide
     };
 
-    QMap<WindowId, WindowInfoWrap> m_windows;
+    QHash<WindowHandle, WindowInfoWrap> m_windows;
+
+    //! geometries of valid tracked windows in order to query only the
+    //! windows that are present in a view screen or its edge band
+    GeometryIndex m_geometryIndex;
 
     //! Some applications delay their application name/icon identification
     //! such as Libreoffice that updates its StartupWMClass after
     //! its startup
     QTimer m_updateApplicationDataTimer;
-    QList<WindowId> m_delayedApplicationData;
-    QList<WindowId> m_initializedApplicationData;
+    QSet<WindowHandle> m_delayedApplicationData;
+    QSet<WindowHandle> m_initializedApplicationData;
+
+    //! application data are resolved outside the gui thread
+    AppDataResolver *m_appDataResolver{nullptr};
 };
 
 }
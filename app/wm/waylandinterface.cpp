@@ -152,7 +152,7 @@ void WaylandInterface::initWindowManagement(KWayland::Client::PlasmaWindowManage
     connect(m_windowManagement, &PlasmaWindowManagement::windowCreated, this, &WaylandInterface::windowCreatedProxy);
     connect(m_windowManagement, &PlasmaWindowManagement::activeWindowChanged, this, [&]() noexcept {
         auto w = m_windowManagement->activeWindow();
-        if (!w || (w && (!m_ignoredWindows.contains(w->internalId()))) ) {
+        if (!w || (w && (!m_ignoredWindows.contains(WindowId(w->internalId())))) ) {
             emit activeWindowChanged(w ? w->internalId() : 0);
         }
 
@@ -224,7 +224,7 @@ KWayland::Client::PlasmaShell *WaylandInterface::waylandCoronaInterface() const
 void WaylandInterface::registerIgnoredWindow(WindowId wid)
 {
     if (!wid.isNull() && !m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.append(wid);
+        m_ignoredWindows.insert(wid);
 
         KWayland::Client::PlasmaWindow *w = windowFor(wid);
 
@@ -239,7 +239,7 @@ void WaylandInterface::registerIgnoredWindow(WindowId wid)
 void WaylandInterface::unregisterIgnoredWindow(WindowId wid)
 {
     if (m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.removeAll(wid);
+        m_ignoredWindows.remove(wid);
         emit windowRemoved(wid);
     }
 }
@@ -553,6 +553,20 @@ AppData WaylandInterface::appDataFor(WindowId wid)
     return empty;
 }
 
+AppMetadata WaylandInterface::appMetadataFor(WindowId wid)
+{
+    AppMetadata metadata;
+
+    auto window = windowFor(wid);
+
+    if (window) {
+        metadata.appId = window->appId();
+        metadata.pid = window->pid();
+    }
+
+    return metadata;
+}
+
 KWayland::Client::PlasmaWindow *WaylandInterface::windowFor(WindowId wid)
 {
     auto it = std::find_if(m_windowManagement->windows().constBegin(), m_windowManagement->windows().constEnd(), [&wid](PlasmaWindow * w) noexcept {
@@ -855,6 +869,15 @@ void WaylandInterface::updateWindow()
     }
 }
 
+void WaylandInterface::updateWindowTitle()
+{
+    PlasmaWindow *pW = qobject_cast<PlasmaWindow*>(QObject::sender());
+
+    if (isValidWindow(pW)) {
+        considerWindowChanged(pW->internalId(), NameChange);
+    }
+}
+
 void WaylandInterface::windowUnmapped()
 {
     PlasmaWindow *pW = qobject_cast<PlasmaWindow*>(QObject::sender());
@@ -872,7 +895,7 @@ void WaylandInterface::trackWindow(KWayland::Client::PlasmaWindow *w)
     }
 
     connect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindow);
+    connect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindowTitle);
     connect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindow);
     connect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindow);
     connect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindow);
@@ -899,7 +922,7 @@ void WaylandInterface::untrackWindow(KWayland::Client::PlasmaWindow *w)
     }
 
     disconnect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindow);
+    disconnect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindowTitle);
     disconnect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindow);
     disconnect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindow);
     disconnect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindow);
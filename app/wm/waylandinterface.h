@@ -92,6 +92,7 @@ public:
     WindowId winIdFor(QString appId, QString title) override;
 
     AppData appDataFor(WindowId wid) override;
+    AppMetadata appMetadataFor(WindowId wid) override;
 
     void setActiveEdge(QWindow *view, bool active)  override;
 
@@ -113,6 +114,7 @@ public:
 
 private slots:
     void updateWindow();
+    void updateWindowTitle();
     void windowUnmapped();
 
 private:
@@ -24,374 +24,445 @@
 namespace Latte {
 namespace WindowSystem {
 
+//! string ids get values with the highest bit set in order to never
+//! collide with numeric window ids
+#define INTERNEDHANDLEFLAG (Q_UINT64_C(1) << 63)
+
+WindowHandle::WindowHandle(const WindowId &wid)
+{
+    if (wid.isNull()) {
+        m_value = 0;
+    } else if (wid.type() == QVariant::String || wid.type() == QVariant::ByteArray) {
+        m_value = internedValue(wid.toString());
+    } else {
+        m_value = wid.toULongLong();
+    }
+}
+
+WindowHandle::InternTable &WindowHandle::internTable()
+{
+    //! windows are tracked only from the gui thread
+    static InternTable s_table;
+    return s_table;
+}
+
+quint64 WindowHandle::internedValue(const QString &id)
+{
+    if (id.isEmpty()) {
+        return 0;
+    }
+
+    InternTable &table = internTable();
+    auto it = table.values.constFind(id);
+
+    if (it != table.values.constEnd()) {
+        return it.value();
+    }
+
+    quint64 value = INTERNEDHANDLEFLAG | table.nextValue++;
+    table.values[id] = value;
+    table.ids[value] = id;
+
+    return value;
+}
+
+void WindowHandle::release(const WindowId &wid)
+{
+    if (wid.type() != QVariant::String && wid.type() != QVariant::ByteArray) {
+        return;
+    }
+
+    InternTable &table = internTable();
+    auto it = table.values.find(wid.toString());
+
+    if (it == table.values.end()) {
+        return;
+    }
+
+    table.ids.remove(it.value());
+    table.values.erase(it);
+}
+
+WindowId WindowHandle::toWindowId() const
+{
+    if (isInterned()) {
+        return internTable().ids.value(m_value);
+    }
+
+    return (qulonglong)m_value;
+}
+
+bool WindowHandle::isNull() const
+{
+    return m_value == 0;
+}
+
+bool WindowHandle::isInterned() const
+{
+    return (m_value & INTERNEDHANDLEFLAG);
+}
+
+quint64 WindowHandle::value() const
+{
+    return m_value;
+}
+
+bool WindowHandle::operator==(const WindowHandle &rhs) const
+{
+    return m_value == rhs.m_value;
+}
+
+bool WindowHandle::operator!=(const WindowHandle &rhs) const
+{
+    return m_value != rhs.m_value;
+}
+
+bool WindowHandle::operator<(const WindowHandle &rhs) const
+{
+    return m_value < rhs.m_value;
+}
+
+//! the last bit is shared from all ids that could not get their own bit
+#define MEMBERSHIPBITS 63
+#define MEMBERSHIPOVERFLOWMASK (Q_UINT64_C(1) << MEMBERSHIPBITS)
+
+MembershipIds *MembershipIds::desktops()
+{
+    //! windows are tracked only from the gui thread
+    static MembershipIds s_desktops;
+    return &s_desktops;
+}
+
+MembershipIds *MembershipIds::activities()
+{
+    static MembershipIds s_activities;
+    return &s_activities;
+}
+
+bool MembershipIds::isOverflowMask(const quint64 &mask)
+{
+    return (mask & MEMBERSHIPOVERFLOWMASK);
+}
+
+quint64 MembershipIds::mask(const QString &id)
+{
+    auto it = m_bits.constFind(id);
+
+    if (it != m_bits.constEnd()) {
+        return (Q_UINT64_C(1) << it.value());
+    }
+
+    if (m_bits.count() >= MEMBERSHIPBITS) {
+        return MEMBERSHIPOVERFLOWMASK;
+    }
+
+    int bit = m_bits.count();
+    m_bits[id] = bit;
+
+    return (Q_UINT64_C(1) << bit);
+}
+
+quint64 MembershipIds::mask(const QStringList &ids)
+{
+    quint64 result{0};
+
+    for (const auto &id : ids) {
+        result |= mask(id);
+    }
+
+    return result;
+}
+
+class WindowInfoWrap::ColdData : public QSharedData
+{
+public:
+    QString appName;
+    QString display;
+    QIcon icon;
+
+    //! names are needed only when membership masks can not be trusted
+    QStringList desktops;
+    QStringList activities;
+};
+
+//! windows without application data share the same empty cold data
+const QSharedDataPointer<WindowInfoWrap::ColdData> &WindowInfoWrap::emptyColdData()
+{
+    static const QSharedDataPointer<ColdData> s_empty(new ColdData);
+    return s_empty;
+}
+
 WindowInfoWrap::WindowInfoWrap()
+    : m_cold(emptyColdData())
 {
 }
 
-WindowInfoWrap::WindowInfoWrap(const WindowInfoWrap &o)
-    : m_wid(o.m_wid)
-    , m_parentId(o.m_parentId)
-    , m_geometry(o.m_geometry)
-    , m_isValid(o.m_isValid)
-    , m_isActive(o.m_isActive)
-    , m_isMinimized(o.m_isMinimized)
-    , m_isMaxVert(o.m_isMaxVert)
-    , m_isMaxHoriz(o.m_isMaxHoriz)
-    , m_isFullscreen(o.m_isFullscreen)
-    , m_isShaded(o.m_isShaded)
-    , m_isKeepAbove(o.m_isKeepAbove)
-    , m_isKeepBelow(o.m_isKeepBelow)
-    , m_hasSkipPager(o.m_hasSkipPager)
-    , m_hasSkipSwitcher(o.m_hasSkipSwitcher)
-    , m_hasSkipTaskbar(o.m_hasSkipTaskbar)
-    , m_isOnAllDesktops(o.m_isOnAllDesktops)
-    , m_isOnAllActivities(o.m_isOnAllActivities)
-    , m_isClosable(o.m_isClosable)
-    , m_isFullScreenable(o.m_isFullScreenable)
-    , m_isGroupable(o.m_isGroupable)
-    , m_isMaximizable(o.m_isMaximizable)
-    , m_isMinimizable(o.m_isMinimizable)
-    , m_isMovable(o.m_isMovable)
-    , m_isResizable(o.m_isResizable)
-    , m_isShadeable(o.m_isShadeable)
-    , m_isVirtualDesktopsChangeable(o.m_isVirtualDesktopsChangeable)
-    , m_desktops(o.m_desktops)
-    , m_activities(o.m_activities)
-    , m_display(o.m_display)
-{
-}
-
-WindowInfoWrap::WindowInfoWrap(WindowInfoWrap &&o)
-    : m_wid(o.m_wid)
-    , m_parentId(o.m_parentId)
-    , m_geometry(o.m_geometry)
-    , m_isValid(o.m_isValid)
-    , m_isActive(o.m_isActive)
-    , m_isMinimized(o.m_isMinimized)
-    , m_isMaxVert(o.m_isMaxVert)
-    , m_isMaxHoriz(o.m_isMaxHoriz)
-    , m_isFullscreen(o.m_isFullscreen)
-    , m_isShaded(o.m_isShaded)
-    , m_isKeepAbove(o.m_isKeepAbove)
-    , m_isKeepBelow(o.m_isKeepBelow)
-    , m_hasSkipPager(o.m_hasSkipPager)
-    , m_hasSkipSwitcher(o.m_hasSkipSwitcher)
-    , m_hasSkipTaskbar(o.m_hasSkipTaskbar)
-    , m_isOnAllDesktops(o.m_isOnAllDesktops)
-    , m_isOnAllActivities(o.m_isOnAllActivities)
-    , m_isClosable(o.m_isClosable)
-    , m_isFullScreenable(o.m_isFullScreenable)
-    , m_isGroupable(o.m_isGroupable)
-    , m_isMaximizable(o.m_isMaximizable)
-    , m_isMinimizable(o.m_isMinimizable)
-    , m_isMovable(o.m_isMovable)
-    , m_isResizable(o.m_isResizable)
-    , m_isShadeable(o.m_isShadeable)
-    , m_isVirtualDesktopsChangeable(o.m_isVirtualDesktopsChangeable)
-    , m_desktops(o.m_desktops)
-    , m_activities(o.m_activities)
-    , m_display(o.m_display)
+WindowInfoWrap::WindowInfoWrap(const WindowInfoWrap &o) = default;
+
+//! moves take over the cold data without touching its reference count
+WindowInfoWrap::WindowInfoWrap(WindowInfoWrap &&o) = default;
+
+WindowInfoWrap::~WindowInfoWrap()
 {
 }
 
 //! Operators
 // BEGIN: definitions
-WindowInfoWrap &WindowInfoWrap::operator=(WindowInfoWrap &&rhs)
+WindowInfoWrap &WindowInfoWrap::operator=(WindowInfoWrap &&rhs) = default;
+
+WindowInfoWrap &WindowInfoWrap::operator=(const WindowInfoWrap &rhs)
 {
     m_wid = rhs.m_wid;
     m_parentId = rhs.m_parentId;
     m_geometry = rhs.m_geometry;
-    m_isValid = rhs.m_isValid;
-    m_isActive = rhs.m_isActive;
-    m_isMinimized = rhs.m_isMinimized;
-    m_isMaxVert = rhs.m_isMaxVert;
-    m_isMaxHoriz = rhs.m_isMaxHoriz;
-    m_isFullscreen = rhs.m_isFullscreen;
-    m_isShaded = rhs.m_isShaded;
-    m_isKeepAbove = rhs.m_isKeepAbove;
-    m_isKeepBelow = rhs.m_isKeepBelow;
-    m_hasSkipPager = rhs.m_hasSkipPager;
-    m_hasSkipSwitcher = rhs.m_hasSkipSwitcher;
-    m_hasSkipTaskbar = rhs.m_hasSkipTaskbar;
-    m_isOnAllDesktops = rhs.m_isOnAllDesktops;
-    m_isOnAllActivities = rhs.m_isOnAllActivities;
-    m_isClosable = rhs.m_isClosable;
-    m_isFullScreenable = rhs.m_isFullScreenable;
-    m_isGroupable = rhs.m_isGroupable;
-    m_isMaximizable = rhs.m_isMaximizable;
-    m_isMinimizable = rhs.m_isMinimizable;
-    m_isMovable = rhs.m_isMovable;
-    m_isResizable = rhs.m_isResizable;
-    m_isShadeable = rhs.m_isShadeable;
-    m_isVirtualDesktopsChangeable = rhs.m_isVirtualDesktopsChangeable;
-
-    m_display = rhs.m_display;
-    m_desktops = rhs.m_desktops;
-    m_activities = rhs.m_activities;
+    m_flags = rhs.m_flags;
+    m_desktopsMask = rhs.m_desktopsMask;
+    m_activitiesMask = rhs.m_activitiesMask;
+    m_cold = rhs.m_cold;
     return *this;
 }
+// END: definitions
 
-WindowInfoWrap &WindowInfoWrap::operator=(const WindowInfoWrap &rhs)
+inline bool WindowInfoWrap::hasFlag(StateFlag flag) const
 {
-    m_wid = rhs.m_wid;
-    m_parentId = rhs.m_parentId;
-    m_geometry = rhs.m_geometry;
-    m_isValid = rhs.m_isValid;
-    m_isActive = rhs.m_isActive;
-    m_isMinimized = rhs.m_isMinimized;
-    m_isMaxVert = rhs.m_isMaxVert;
-    m_isMaxHoriz = rhs.m_isMaxHoriz;
-    m_isFullscreen = rhs.m_isFullscreen;
-    m_isShaded = rhs.m_isShaded;
-    m_isKeepAbove = rhs.m_isKeepAbove;
-    m_isKeepBelow = rhs.m_isKeepBelow;
-    m_hasSkipPager = rhs.m_hasSkipPager;
-    m_hasSkipSwitcher = rhs.m_hasSkipSwitcher;
-    m_hasSkipTaskbar = rhs.m_hasSkipTaskbar;
-    m_isOnAllDesktops = rhs.m_isOnAllDesktops;
-    m_isOnAllActivities = rhs.m_isOnAllActivities;
-    m_isClosable = rhs.m_isClosable;
-    m_isFullScreenable = rhs.m_isFullScreenable;
-    m_isGroupable = rhs.m_isGroupable;
-    m_isMaximizable = rhs.m_isMaximizable;
-    m_isMinimizable = rhs.m_isMinimizable;
-    m_isMovable = rhs.m_isMovable;
-    m_isResizable = rhs.m_isResizable;
-    m_isShadeable = rhs.m_isShadeable;
-    m_isVirtualDesktopsChangeable = rhs.m_isVirtualDesktopsChangeable;
-
-    m_display = rhs.m_display;
-    m_desktops = rhs.m_desktops;
-    m_activities = rhs.m_activities;
-    return *this;
+    return (m_flags & flag);
+}
+
+inline void WindowInfoWrap::setFlag(StateFlag flag, bool on)
+{
+    if (on) {
+        m_flags |= flag;
+    } else {
+        m_flags &= ~flag;
+    }
 }
 
 //! Access properties
 bool WindowInfoWrap::isValid() const
 {
-    return m_isValid;
+    return hasFlag(IsValidFlag);
 }
 
 void WindowInfoWrap::setIsValid(bool isValid)
 {
-    m_isValid = isValid;
+    setFlag(IsValidFlag, isValid);
 }
 
 bool WindowInfoWrap::isActive() const
 {
-    return m_isActive;
+    return hasFlag(IsActiveFlag);
 }
 
 void WindowInfoWrap::setIsActive(bool isActive)
 {
-    m_isActive = isActive;
+    setFlag(IsActiveFlag, isActive);
 }
 
 bool WindowInfoWrap::isMinimized() const
 {
-    return m_isMinimized;
+    return hasFlag(IsMinimizedFlag);
 }
 
 void WindowInfoWrap::setIsMinimized(bool isMinimized)
 {
-    m_isMinimized = isMinimized;
+    setFlag(IsMinimizedFlag, isMinimized);
 }
 
 bool WindowInfoWrap::isMaximized() const
 {
-    return m_isMaxVert && m_isMaxHoriz;
+    return hasFlag(IsMaxVertFlag) && hasFlag(IsMaxHorizFlag);
 }
 
 bool WindowInfoWrap::isMaxVert() const
 {
-    return m_isMaxVert;
+    return hasFlag(IsMaxVertFlag);
 }
 
 void WindowInfoWrap::setIsMaxVert(bool isMaxVert)
 {
-    m_isMaxVert = isMaxVert;
+    setFlag(IsMaxVertFlag, isMaxVert);
 }
 
 bool WindowInfoWrap::isMaxHoriz() const
 {
-    return m_isMaxHoriz;
+    return hasFlag(IsMaxHorizFlag);
 }
 
 void WindowInfoWrap::setIsMaxHoriz(bool isMaxHoriz)
 {
-    m_isMaxHoriz = isMaxHoriz;
+    setFlag(IsMaxHorizFlag, isMaxHoriz);
 }
 
 bool WindowInfoWrap::isFullscreen() const
 {
-    return m_isFullscreen;
+    return hasFlag(IsFullscreenFlag);
 }
 
 void WindowInfoWrap::setIsFullscreen(bool isFullscreen)
 {
-    m_isFullscreen = isFullscreen;
+    setFlag(IsFullscreenFlag, isFullscreen);
 }
 
 bool WindowInfoWrap::isShaded() const
 {
-    return m_isShaded;
+    return hasFlag(IsShadedFlag);
 }
 
 void WindowInfoWrap::setIsShaded(bool isShaded)
 {
-    m_isShaded = isShaded;
+    setFlag(IsShadedFlag, isShaded);
 }
 
 bool WindowInfoWrap::isKeepAbove() const
 {
-    return m_isKeepAbove;
+    return hasFlag(IsKeepAboveFlag);
 }
 
 void WindowInfoWrap::setIsKeepAbove(bool isKeepAbove)
 {
-    m_isKeepAbove = isKeepAbove;
+    setFlag(IsKeepAboveFlag, isKeepAbove);
 }
 
 bool WindowInfoWrap::isKeepBelow() const
 {
-    return m_isKeepBelow;
+    return hasFlag(IsKeepBelowFlag);
 }
 
 void WindowInfoWrap::setIsKeepBelow(bool isKeepBelow)
 {
-    m_isKeepBelow = isKeepBelow;
+    setFlag(IsKeepBelowFlag, isKeepBelow);
 }
 
 bool WindowInfoWrap::hasSkipPager() const
 {
-    return m_hasSkipPager;
+    return hasFlag(HasSkipPagerFlag);
 }
 
 void WindowInfoWrap::setHasSkipPager(bool skipPager)
 {
-    m_hasSkipPager = skipPager;
+    setFlag(HasSkipPagerFlag, skipPager);
 }
 
 bool WindowInfoWrap::hasSkipSwitcher() const
 {
-    return m_hasSkipSwitcher;
+    return hasFlag(HasSkipSwitcherFlag);
 }
 
 void WindowInfoWrap::setHasSkipSwitcher(bool skipSwitcher)
 {
-    m_hasSkipSwitcher = skipSwitcher;
+    setFlag(HasSkipSwitcherFlag, skipSwitcher);
 }
 
 bool WindowInfoWrap::hasSkipTaskbar() const
 {
-    return m_hasSkipTaskbar;
+    return hasFlag(HasSkipTaskbarFlag);
 }
 
 void WindowInfoWrap::setHasSkipTaskbar(bool skipTaskbar)
 {
-    m_hasSkipTaskbar = skipTaskbar;
+    setFlag(HasSkipTaskbarFlag, skipTaskbar);
 }
 
 bool WindowInfoWrap::isOnAllDesktops() const
 {
-    return m_isOnAllDesktops;
+    return hasFlag(IsOnAllDesktopsFlag);
 }
 
 void WindowInfoWrap::setIsOnAllDesktops(bool alldesktops)
 {
-    m_isOnAllDesktops = alldesktops;
+    setFlag(IsOnAllDesktopsFlag, alldesktops);
 }
 
 bool WindowInfoWrap::isOnAllActivities() const
 {
-    return m_isOnAllActivities;
+    return hasFlag(IsOnAllActivitiesFlag);
 }
 
 void WindowInfoWrap::setIsOnAllActivities(bool allactivities)
 {
-    m_isOnAllActivities = allactivities;
+    setFlag(IsOnAllActivitiesFlag, allactivities);
 }
 
 //!BEGIN: Window Abilities
 bool WindowInfoWrap::isCloseable() const
 {
-    return m_isClosable;
+    return hasFlag(IsClosableFlag);
 }
 void WindowInfoWrap::setIsClosable(bool closable)
 {
-    m_isClosable = closable;
+    setFlag(IsClosableFlag, closable);
 }
 
 bool WindowInfoWrap::isFullScreenable() const
 {
-    return m_isFullScreenable;
+    return hasFlag(IsFullScreenableFlag);
 }
 void WindowInfoWrap::setIsFullScreenable(bool fullscreenable)
 {
-    m_isFullScreenable = fullscreenable;
+    setFlag(IsFullScreenableFlag, fullscreenable);
 }
 
 bool WindowInfoWrap::isGroupable() const
 {
-    return m_isGroupable;
+    return hasFlag(IsGroupableFlag);
 }
 void WindowInfoWrap::setIsGroupable(bool groupable)
 {
-    m_isGroupable = groupable;
+    setFlag(IsGroupableFlag, groupable);
 }
 
 bool WindowInfoWrap::isMaximizable() const
 {
-    return m_isMaximizable;
+    return hasFlag(IsMaximizableFlag);
 }
 void WindowInfoWrap::setIsMaximizable(bool maximizable)
 {
-    m_isMaximizable = maximizable;
+    setFlag(IsMaximizableFlag, maximizable);
 }
 
 bool WindowInfoWrap::isMinimizable() const
 {
-    return m_isMinimizable;
+    return hasFlag(IsMinimizableFlag);
 }
 void WindowInfoWrap::setIsMinimizable(bool minimizable)
 {
-    m_isMinimizable = minimizable;
+    setFlag(IsMinimizableFlag, minimizable);
 }
 
 bool WindowInfoWrap::isMovable() const
 {
-    return m_isMovable;
+    return hasFlag(IsMovableFlag);
 }
 void WindowInfoWrap::setIsMovable(bool movable)
 {
-    m_isMovable = movable;
+    setFlag(IsMovableFlag, movable);
 }
 
 bool WindowInfoWrap::isResizable() const
 {
-    return m_isResizable;
+    return hasFlag(IsResizableFlag);
 }
 void WindowInfoWrap::setIsResizable(bool resizable)
 {
-    m_isResizable = resizable;
+    setFlag(IsResizableFlag, resizable);
 }
 
 bool WindowInfoWrap::isShadeable() const
 {
-    return m_isShadeable;
+    return hasFlag(IsShadeableFlag);
 }
 void WindowInfoWrap::setIsShadeable(bool shadeble)
 {
-    m_isShadeable = shadeble;
+    setFlag(IsShadeableFlag, shadeble);
 }
 
 bool WindowInfoWrap::isVirtualDesktopsChangeable() const
 {
-    return m_isVirtualDesktopsChangeable;
+    return hasFlag(IsVirtualDesktopsChangeableFlag);
 }
 void WindowInfoWrap::setIsVirtualDesktopsChangeable(bool virtualdesktopchangeable)
 {
-    m_isVirtualDesktopsChangeable = virtualdesktopchangeable;
+    setFlag(IsVirtualDesktopsChangeableFlag, virtualdesktopchangeable);
 }
 //!END: Window Abilities
 
@@ -399,43 +470,43 @@ void WindowInfoWrap::setIsVirtualDesktopsChangeable(bool virtualdesktopchangeabl
 
 bool WindowInfoWrap::isMainWindow() const
 {
-    return (m_parentId.toInt() <= 0);
+    return m_parentId.isNull();
 }
 
 bool WindowInfoWrap::isChildWindow() const
 {
-    return (m_parentId.toInt() > 0);
+    return !m_parentId.isNull();
 }
 
 
 QString WindowInfoWrap::appName() const
 {
-    return m_appName;
+    return m_cold->appName;
 }
 
 void WindowInfoWrap::setAppName(const QString &appName)
 {
-    m_appName = appName;
+    m_cold->appName = appName;
 }
 
 QString WindowInfoWrap::display() const
 {
-    return m_display;
+    return m_cold->display;
 }
 
 void WindowInfoWrap::setDisplay(const QString &display)
 {
-    m_display = display;
+    m_cold->display = display;
 }
 
 QIcon WindowInfoWrap::icon() const
 {
-    return m_icon;
+    return m_cold->icon;
 }
 
 void WindowInfoWrap::setIcon(const QIcon &icon)
 {
-    m_icon = icon;
+    m_cold->icon = icon;
 }
 
 QRect WindowInfoWrap::geometry() const
@@ -450,7 +521,7 @@ void WindowInfoWrap::setGeometry(const QRect &geometry)
 
 WindowId WindowInfoWrap::wid() const
 {
-    return m_wid;
+    return m_wid.toWindowId();
 }
 
 void WindowInfoWrap::setWid(const WindowId &wid)
@@ -460,46 +531,86 @@ void WindowInfoWrap::setWid(const WindowId &wid)
 
 WindowId WindowInfoWrap::parentId() const
 {
-    return m_parentId;
+    return m_parentId.toWindowId();
 }
 
 void WindowInfoWrap::setParentId(const WindowId &parentId)
 {
-    if (m_wid == parentId) {
+    const WindowHandle parent(parentId);
+
+    if (m_wid == parent) {
         return;
     }
 
-    m_parentId = parentId;
+    m_parentId = parent;
+}
+
+WindowHandle WindowInfoWrap::handle() const
+{
+    return m_wid;
+}
+
+WindowHandle WindowInfoWrap::parentHandle() const
+{
+    return m_parentId;
 }
 
 QStringList WindowInfoWrap::desktops() const
 {
-    return m_desktops;
+    return m_cold->desktops;
 }
 
 void WindowInfoWrap::setDesktops(const QStringList &desktops)
 {
-    m_desktops = desktops;
+    m_cold->desktops = desktops;
+    m_desktopsMask = MembershipIds::desktops()->mask(desktops);
 }
 
 QStringList WindowInfoWrap::activities() const
 {
-    return m_activities;
+    return m_cold->activities;
 }
 
 void WindowInfoWrap::setActivities(const QStringList &activities)
 {
-    m_activities = activities;
+    m_cold->activities = activities;
+    m_activitiesMask = MembershipIds::activities()->mask(activities);
 }
 
 bool WindowInfoWrap::isOnDesktop(const QString &desktop) const
 {
-    return m_isOnAllDesktops || m_desktops.contains(desktop);
+    return hasFlag(IsOnAllDesktopsFlag) || m_cold->desktops.contains(desktop);
 }
 
 bool WindowInfoWrap::isOnActivity(const QString &activity) const
 {
-    return m_isOnAllActivities || m_activities.contains(activity);
+    return hasFlag(IsOnAllActivitiesFlag) || m_cold->activities.contains(activity);
+}
+
+bool WindowInfoWrap::isOnDesktop(const quint64 &desktopMask, const QString &desktop) const
+{
+    if (hasFlag(IsOnAllDesktopsFlag)) {
+        return true;
+    }
+
+    if (MembershipIds::isOverflowMask(desktopMask)) {
+        return m_cold->desktops.contains(desktop);
+    }
+
+    return (m_desktopsMask & desktopMask);
+}
+
+bool WindowInfoWrap::isOnActivity(const quint64 &activityMask, const QString &activity) const
+{
+    if (hasFlag(IsOnAllActivitiesFlag)) {
+        return true;
+    }
+
+    if (MembershipIds::isOverflowMask(activityMask)) {
+        return m_cold->activities.contains(activity);
+    }
+
+    return (m_activitiesMask & activityMask);
 }
 
 }
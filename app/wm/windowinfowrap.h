@@ -22,9 +22,11 @@
 #define WINDOWINFOWRAP_H
 
 // Qt
+#include <QHash>
 #include <QWindow>
 #include <QIcon>
 #include <QRect>
+#include <QSharedDataPointer>
 #include <QVariant>
 
 namespace Latte {
@@ -32,6 +34,73 @@ namespace WindowSystem {
 
 using WindowId = QVariant;
 
+//! Compact and trivially copyable representation of a WindowId. Numeric window ids
+//! (X11 window ids, Wayland internal ids) are stored as they are and string ids are
+//! interned to unique integers. It is used as key for windows containers in order
+//! to avoid QVariant comparisons and allocations in hot paths
+class WindowHandle
+{
+
+public:
+    WindowHandle() = default;
+    WindowHandle(const WindowId &wid);
+
+    bool isNull() const;
+    //! true for handles of string ids
+    bool isInterned() const;
+    quint64 value() const;
+
+    //! the window id that the handle was created from, numeric ids
+    //! are provided as unsigned 64bit integers
+    WindowId toWindowId() const;
+
+    //! string ids of removed windows are released from the intern table,
+    //! their values are never given again to other ids
+    static void release(const WindowId &wid);
+
+    bool operator==(const WindowHandle &rhs) const;
+    bool operator!=(const WindowHandle &rhs) const;
+    bool operator<(const WindowHandle &rhs) const;
+
+private:
+    struct InternTable {
+        QHash<QString, quint64> values;
+        QHash<quint64, QString> ids;
+        quint64 nextValue{1};
+    };
+
+    static InternTable &internTable();
+    static quint64 internedValue(const QString &id);
+
+private:
+    quint64 m_value{0};
+};
+
+inline uint qHash(const WindowHandle &handle, uint seed = 0)
+{
+    return ::qHash(handle.value(), seed);
+}
+
+//! Virtual desktops and activities ids are interned to bit positions in order for
+//! window membership to be stored as a bitset. That way checking a window against the
+//! current desktop/activity is a single AND. Ids that do not fit in the available bits
+//! share the overflow bit and for them membership is checked with their names
+class MembershipIds
+{
+
+public:
+    static MembershipIds *desktops();
+    static MembershipIds *activities();
+
+    quint64 mask(const QString &id);
+    quint64 mask(const QStringList &ids);
+
+    static bool isOverflowMask(const quint64 &mask);
+
+private:
+    QHash<QString, int> m_bits;
+};
+
 class WindowInfoWrap
 {
 
@@ -39,6 +108,7 @@ public:
     WindowInfoWrap();
     WindowInfoWrap(const WindowInfoWrap &o);
     WindowInfoWrap(WindowInfoWrap &&o);
+    ~WindowInfoWrap();
 
     WindowInfoWrap &operator=(WindowInfoWrap &&rhs);
     WindowInfoWrap &operator=(const WindowInfoWrap &rhs);
@@ -137,6 +207,10 @@ public:
     WindowId parentId() const;
     void setParentId(const WindowId &parentId);
 
+    //! window ids as they are stored, they are preferred during windows tracking
+    WindowHandle handle() const;
+    WindowHandle parentHandle() const;
+
     QStringList desktops() const;
     void setDesktops(const QStringList &desktops);
 
@@ -146,46 +220,66 @@ public:
     bool isOnDesktop(const QString &desktop) const;
     bool isOnActivity(const QString &activity) const;
 
-private:
-    WindowId m_wid{0};
-    WindowId m_parentId{0};
+    //! fast membership checks, masks are provided from MembershipIds and
+    //! names are used only when masks can not be trusted
+    bool isOnDesktop(const quint64 &desktopMask, const QString &desktop) const;
+    bool isOnActivity(const quint64 &activityMask, const QString &activity) const;
 
-    QRect m_geometry;
+private:
+    //! state flags of the window, they are packed in order to keep
+    //! the information that is used in windows tracking small and cheap to copy
+    enum StateFlag
+    {
+        IsValidFlag = 0x000001,
+        IsActiveFlag = 0x000002,
+        IsMinimizedFlag = 0x000004,
+        IsMaxVertFlag = 0x000008,
+        IsMaxHorizFlag = 0x000010,
+        IsFullscreenFlag = 0x000020,
+        IsShadedFlag = 0x000040,
+        IsKeepAboveFlag = 0x000080,
+        IsKeepBelowFlag = 0x000100,
+        HasSkipPagerFlag = 0x000200,
+        HasSkipSwitcherFlag = 0x000400,
+        HasSkipTaskbarFlag = 0x000800,
+        IsOnAllDesktopsFlag = 0x001000,
+        IsOnAllActivitiesFlag = 0x002000,
+        //!BEGIN: Window Abilities
+        IsClosableFlag = 0x004000,
+        IsFullScreenableFlag = 0x008000,
+        IsGroupableFlag = 0x010000,
+        IsMaximizableFlag = 0x020000,
+        IsMinimizableFlag = 0x040000,
+        IsMovableFlag = 0x080000,
+        IsResizableFlag = 0x100000,
+        IsShadeableFlag = 0x200000,
+        IsVirtualDesktopsChangeableFlag = 0x400000
+        //!END: Window Abilities
+    };
+
+    //! information that is not needed during windows tracking, it is implicitly
+    //! shared between copies and it is detached only when it is modified
+    class ColdData;
+
+    bool hasFlag(StateFlag flag) const;
+    void setFlag(StateFlag flag, bool on);
+
+    static const QSharedDataPointer<ColdData> &emptyColdData();
 
-    bool m_isValid{false};
-    bool m_isActive{false};
-    bool m_isMinimized{false};
-    bool m_isMaxVert{false};
-    bool m_isMaxHoriz{false};
-    bool m_isFullscreen{false};
-    bool m_isShaded{false};
-    bool m_isKeepAbove{false};
-    bool m_isKeepBelow{false};
-    bool m_hasSkipPager{false};
-    bool m_hasSkipSwitcher{false};
-    bool m_hasSkipTaskbar{false};
-    bool m_isOnAllDesktops{false};
-    bool m_isOnAllActivities{false};
+private:
+    //!BEGIN: hot data, used during windows tracking
+    WindowHandle m_wid;
+    WindowHandle m_parentId;
 
-    //!BEGIN: Window Abilities
-    bool m_isClosable{false};
-    bool m_isFullScreenable{false};
-    bool m_isGroupable{false};
-    bool m_isMaximizable{false};
-    bool m_isMinimizable{false};
-    bool m_isMovable{false};
-    bool m_isResizable{false};
-    bool m_isShadeable{false};
-    bool m_isVirtualDesktopsChangeable{false};
-    //!END: Window Abilities
+    QRect m_geometry;
 
-    QString m_appName;
-    QString m_display;
+    quint32 m_flags{0};
 
-    QIcon m_icon;
+    quint64 m_desktopsMask{0};
+    quint64 m_activitiesMask{0};
+    //!END: hot data
 
-    QStringList m_desktops;
-    QStringList m_activities;
+    QSharedDataPointer<ColdData> m_cold;
 };
 
 }
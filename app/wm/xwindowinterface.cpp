@@ -29,14 +29,17 @@
 // Qt
 #include <QDebug>
 #include <QTimer>
+#include <QVector>
 #include <QtX11Extras/QX11Info>
 
 // KDE
-#include <KDesktopFile>
 #include <KWindowSystem>
 #include <KWindowInfo>
 #include <KIconThemes/KIconLoader>
 
+// C++
+#include <algorithm>
+
 // X11
 #include <NETWM>
 #include <xcb/xcb.h>
@@ -45,6 +48,104 @@
 namespace Latte {
 namespace WindowSystem {
 
+namespace {
+//! must follow the XWindowInterface::XcbAtom order
+const char *const ATOMNAMES[] = {
+    "_NET_WM_STATE",
+    "_NET_WM_DESKTOP",
+    "_NET_WM_WINDOW_TYPE",
+    "_NET_WM_WINDOW_TYPE_DESKTOP",
+    "_NET_FRAME_EXTENTS",
+    "_GTK_FRAME_EXTENTS",
+    "_KDE_NET_WM_ACTIVITIES",
+    "_NET_WM_ALLOWED_ACTIONS",
+    "_NET_WM_NAME",
+    "_NET_WM_VISIBLE_NAME",
+    "UTF8_STRING",
+    "_NET_WM_STATE_HIDDEN",
+    "_NET_WM_STATE_MAXIMIZED_VERT",
+    "_NET_WM_STATE_MAXIMIZED_HORZ",
+    "_NET_WM_STATE_FULLSCREEN",
+    "_NET_WM_STATE_SHADED",
+    "_NET_WM_STATE_ABOVE",
+    "_NET_WM_STATE_BELOW",
+    "_NET_WM_STATE_SKIP_PAGER",
+    "_NET_WM_STATE_SKIP_TASKBAR",
+    "_KDE_NET_WM_STATE_SKIP_SWITCHER",
+    "_NET_WM_ACTION_CLOSE",
+    "_NET_WM_ACTION_FULLSCREEN",
+    "_NET_WM_ACTION_MAXIMIZE_VERT",
+    "_NET_WM_ACTION_MAXIMIZE_HORZ",
+    "_NET_WM_ACTION_MINIMIZE",
+    "_NET_WM_ACTION_MOVE",
+    "_NET_WM_ACTION_RESIZE",
+    "_NET_WM_ACTION_SHADE",
+    "_NET_WM_ACTION_CHANGE_DESKTOP"
+};
+
+struct WindowCookies {
+    xcb_window_t window;
+    xcb_get_geometry_cookie_t geometry;
+    xcb_translate_coordinates_cookie_t position;
+    xcb_get_property_cookie_t state;
+    xcb_get_property_cookie_t desktop;
+    xcb_get_property_cookie_t windowType;
+    xcb_get_property_cookie_t frameExtents;
+    xcb_get_property_cookie_t gtkFrameExtents;
+    xcb_get_property_cookie_t activities;
+    xcb_get_property_cookie_t windowClass;
+    xcb_get_property_cookie_t allowedActions;
+    xcb_get_property_cookie_t transientFor;
+    xcb_get_property_cookie_t visibleName;
+    xcb_get_property_cookie_t name;
+    xcb_get_property_cookie_t wmName;
+};
+
+//! 32bit values of a property reply, the reply is released
+QVector<uint32_t> propertyValues(xcb_connection_t *c, xcb_get_property_cookie_t cookie, xcb_atom_t type)
+{
+    QScopedPointer<xcb_get_property_reply_t, QScopedPointerPodDeleter> reply(xcb_get_property_reply(c, cookie, nullptr));
+
+    if (!reply || reply->type != type || reply->format != 32) {
+        return QVector<uint32_t>();
+    }
+
+    const uint32_t *data = static_cast<const uint32_t *>(xcb_get_property_value(reply.data()));
+    const int count = xcb_get_property_value_length(reply.data()) / sizeof(uint32_t);
+
+    QVector<uint32_t> values(count);
+    std::copy(data, data + count, values.begin());
+
+    return values;
+}
+
+//! 8bit value of a property reply, the reply is released. Values longer than the
+//! first request, e.g. long titles, are completed with one more request
+QByteArray propertyBytes(xcb_connection_t *c, xcb_get_property_cookie_t cookie, xcb_window_t window, xcb_atom_t property, xcb_atom_t type)
+{
+    QScopedPointer<xcb_get_property_reply_t, QScopedPointerPodDeleter> reply(xcb_get_property_reply(c, cookie, nullptr));
+
+    if (!reply || reply->format != 8 || (type != XCB_GET_PROPERTY_TYPE_ANY && reply->type != type)) {
+        return QByteArray();
+    }
+
+    QByteArray value(static_cast<const char *>(xcb_get_property_value(reply.data())), xcb_get_property_value_length(reply.data()));
+
+    if (reply->bytes_after > 0) {
+        //! offset and length are counted in 32bit units
+        xcb_get_property_cookie_t remainderCookie = xcb_get_property_unchecked(c, false, window, property, reply->type,
+                                                                               value.length() / 4, (reply->bytes_after + 3) / 4);
+        QScopedPointer<xcb_get_property_reply_t, QScopedPointerPodDeleter> remainder(xcb_get_property_reply(c, remainderCookie, nullptr));
+
+        if (remainder && remainder->format == 8 && remainder->type == reply->type) {
+            value.append(static_cast<const char *>(xcb_get_property_value(remainder.data())), xcb_get_property_value_length(remainder.data()));
+        }
+    }
+
+    return value;
+}
+}
+
 XWindowInterface::XWindowInterface(QObject *parent)
     : AbstractWindowInterface(parent)
 {
@@ -328,21 +429,257 @@ void XWindowInterface::setActiveEdge(QWindow *view, bool active)
     xcb_change_property(c, XCB_PROP_MODE_REPLACE, window->winId(), atom->atom, XCB_ATOM_CARDINAL, 32, 1, &value);
 }
 
-#if KF5_VERSION_MINOR >= 65
-QRect XWindowInterface::visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const
+bool XWindowInterface::internAtoms()
 {
-    NETWinInfo ni(QX11Info::connection(), wid.toUInt(), QX11Info::appRootWindow(), 0, NET::WM2GTKFrameExtents);
-    NETStrut struts = ni.gtkFrameExtents();
-    QMargins margins(struts.left, struts.top, struts.right, struts.bottom);
-    QRect visibleGeometry = frameGeometry;
+    if (!m_atoms.isEmpty()) {
+        return true;
+    }
+
+    xcb_connection_t *c = QX11Info::connection();
+
+    QVector<xcb_intern_atom_cookie_t> cookies;
+    cookies.reserve(AtomsCount);
+
+    for (int i=0; i<AtomsCount; ++i) {
+        cookies << xcb_intern_atom_unchecked(c, false, qstrlen(ATOMNAMES[i]), ATOMNAMES[i]);
+    }
+
+    QVector<xcb_atom_t> atoms;
+    atoms.reserve(AtomsCount);
+
+    for (const auto &cookie : cookies) {
+        QScopedPointer<xcb_intern_atom_reply_t, QScopedPointerPodDeleter> atom(xcb_intern_atom_reply(c, cookie, nullptr));
+        atoms << (atom ? atom->atom : XCB_ATOM_NONE);
+    }
 
-    if (!margins.isNull()) {
-        visibleGeometry -= margins;
+    if (atoms.contains(XCB_ATOM_NONE)) {
+        return false;
     }
 
-    return visibleGeometry;
+    m_atoms = atoms;
+    return true;
 }
+
+NET::States XWindowInterface::netState(xcb_atom_t atom) const
+{
+    if (atom == m_atoms[AtomStateHidden]) {
+        return NET::Hidden;
+    } else if (atom == m_atoms[AtomStateMaxVert]) {
+        return NET::MaxVert;
+    } else if (atom == m_atoms[AtomStateMaxHoriz]) {
+        return NET::MaxHoriz;
+    } else if (atom == m_atoms[AtomStateFullScreen]) {
+        return NET::FullScreen;
+    } else if (atom == m_atoms[AtomStateShaded]) {
+        return NET::Shaded;
+    } else if (atom == m_atoms[AtomStateKeepAbove]) {
+        return NET::KeepAbove;
+    } else if (atom == m_atoms[AtomStateKeepBelow]) {
+        return NET::KeepBelow;
+    } else if (atom == m_atoms[AtomStateSkipPager]) {
+        return NET::SkipPager;
+    } else if (atom == m_atoms[AtomStateSkipTaskbar]) {
+        return NET::SkipTaskbar;
+#if KF5_VERSION_MINOR >= 45
+    } else if (atom == m_atoms[AtomStateSkipSwitcher]) {
+        return NET::SkipSwitcher;
 #endif
+    }
+
+    return NET::States();
+}
+
+NET::Actions XWindowInterface::netAction(xcb_atom_t atom) const
+{
+    if (atom == m_atoms[AtomActionClose]) {
+        return NET::ActionClose;
+    } else if (atom == m_atoms[AtomActionFullScreen]) {
+        return NET::ActionFullScreen;
+    } else if (atom == m_atoms[AtomActionMaxVert]) {
+        return NET::ActionMaxVert;
+    } else if (atom == m_atoms[AtomActionMaxHoriz]) {
+        return NET::ActionMaxHoriz;
+    } else if (atom == m_atoms[AtomActionMinimize]) {
+        return NET::ActionMinimize;
+    } else if (atom == m_atoms[AtomActionMove]) {
+        return NET::ActionMove;
+    } else if (atom == m_atoms[AtomActionResize]) {
+        return NET::ActionResize;
+    } else if (atom == m_atoms[AtomActionShade]) {
+        return NET::ActionShade;
+    } else if (atom == m_atoms[AtomActionChangeDesktop]) {
+        return NET::ActionChangeDesktop;
+    }
+
+    return NET::Actions();
+}
+
+QList<XWindowInterface::WindowProperties> XWindowInterface::windowProperties(const QList<WindowId> &wids)
+{
+    QList<WindowProperties> properties;
+    xcb_connection_t *c = QX11Info::connection();
+    const xcb_window_t root = QX11Info::appRootWindow();
+
+    //! send all requests first in order to pay only one round trip for all windows
+    QVector<WindowCookies> cookies;
+    cookies.reserve(wids.count());
+
+    for (const auto &wid : wids) {
+        const xcb_window_t window = wid.toUInt();
+
+        WindowCookies windowCookies;
+        windowCookies.window = window;
+        windowCookies.geometry = xcb_get_geometry_unchecked(c, window);
+        windowCookies.position = xcb_translate_coordinates_unchecked(c, window, root, 0, 0);
+        windowCookies.state = xcb_get_property_unchecked(c, false, window, m_atoms[AtomNetWmState], XCB_ATOM_ATOM, 0, 32);
+        windowCookies.desktop = xcb_get_property_unchecked(c, false, window, m_atoms[AtomNetWmDesktop], XCB_ATOM_CARDINAL, 0, 1);
+        windowCookies.windowType = xcb_get_property_unchecked(c, false, window, m_atoms[AtomNetWmWindowType], XCB_ATOM_ATOM, 0, 32);
+        windowCookies.frameExtents = xcb_get_property_unchecked(c, false, window, m_atoms[AtomNetFrameExtents], XCB_ATOM_CARDINAL, 0, 4);
+        windowCookies.gtkFrameExtents = xcb_get_property_unchecked(c, false, window, m_atoms[AtomGtkFrameExtents], XCB_ATOM_CARDINAL, 0, 4);
+        windowCookies.activities = xcb_get_property_unchecked(c, false, window, m_atoms[AtomKdeNetWmActivities], XCB_ATOM_STRING, 0, 1024);
+        windowCookies.windowClass = xcb_get_property_unchecked(c, false, window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, 0, 256);
+        windowCookies.allowedActions = xcb_get_property_unchecked(c, false, window, m_atoms[AtomNetWmAllowedActions], XCB_ATOM_ATOM, 0, 32);
+        windowCookies.transientFor = xcb_get_property_unchecked(c, false, window, XCB_ATOM_WM_TRANSIENT_FOR, XCB_ATOM_WINDOW, 0, 1);
+        windowCookies.visibleName = xcb_get_property_unchecked(c, false, window, m_atoms[AtomNetWmVisibleName], m_atoms[AtomUtf8String], 0, 256);
+        windowCookies.name = xcb_get_property_unchecked(c, false, window, m_atoms[AtomNetWmName], m_atoms[AtomUtf8String], 0, 256);
+        windowCookies.wmName = xcb_get_property_unchecked(c, false, window, XCB_ATOM_WM_NAME, XCB_GET_PROPERTY_TYPE_ANY, 0, 256);
+
+        cookies << windowCookies;
+    }
+
+    const bool allowedActionsSupported = KWindowSystem::allowedActionsSupported();
+
+    //! every reply is collected even for invalid windows in order to release them
+    for (const auto &windowCookies : cookies) {
+        WindowProperties winProperties;
+
+        QScopedPointer<xcb_get_geometry_reply_t, QScopedPointerPodDeleter> geometry(xcb_get_geometry_reply(c, windowCookies.geometry, nullptr));
+        QScopedPointer<xcb_translate_coordinates_reply_t, QScopedPointerPodDeleter> position(xcb_translate_coordinates_reply(c, windowCookies.position, nullptr));
+
+        const QVector<uint32_t> state = propertyValues(c, windowCookies.state, XCB_ATOM_ATOM);
+        const QVector<uint32_t> desktop = propertyValues(c, windowCookies.desktop, XCB_ATOM_CARDINAL);
+        const QVector<uint32_t> windowType = propertyValues(c, windowCookies.windowType, XCB_ATOM_ATOM);
+        const QVector<uint32_t> frameExtents = propertyValues(c, windowCookies.frameExtents, XCB_ATOM_CARDINAL);
+        const QVector<uint32_t> gtkFrameExtents = propertyValues(c, windowCookies.gtkFrameExtents, XCB_ATOM_CARDINAL);
+        const QByteArray activities = propertyBytes(c, windowCookies.activities, windowCookies.window, m_atoms[AtomKdeNetWmActivities], XCB_ATOM_STRING);
+        const QByteArray windowClass = propertyBytes(c, windowCookies.windowClass, windowCookies.window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING);
+        const QVector<uint32_t> allowedActions = propertyValues(c, windowCookies.allowedActions, XCB_ATOM_ATOM);
+        const QVector<uint32_t> transientFor = propertyValues(c, windowCookies.transientFor, XCB_ATOM_WINDOW);
+        const QByteArray visibleName = propertyBytes(c, windowCookies.visibleName, windowCookies.window, m_atoms[AtomNetWmVisibleName], m_atoms[AtomUtf8String]);
+        const QByteArray name = propertyBytes(c, windowCookies.name, windowCookies.window, m_atoms[AtomNetWmName], m_atoms[AtomUtf8String]);
+        const QByteArray wmName = propertyBytes(c, windowCookies.wmName, windowCookies.window, XCB_ATOM_WM_NAME, XCB_GET_PROPERTY_TYPE_ANY);
+
+        if (!geometry || !position) {
+            properties << winProperties;
+            continue;
+        }
+
+        winProperties.valid = true;
+        winProperties.geometry = QRect(position->dst_x, position->dst_y, geometry->width, geometry->height);
+        winProperties.frameGeometry = winProperties.geometry;
+
+        if (frameExtents.count() == 4) {
+            //! _NET_FRAME_EXTENTS order is left, right, top, bottom
+            winProperties.frameGeometry.adjust(-(int)frameExtents[0], -(int)frameExtents[2], (int)frameExtents[1], (int)frameExtents[3]);
+        }
+
+        if (gtkFrameExtents.count() == 4) {
+            //! _GTK_FRAME_EXTENTS order is left, right, top, bottom
+            winProperties.gtkFrameExtents = QMargins(gtkFrameExtents[0], gtkFrameExtents[2], gtkFrameExtents[1], gtkFrameExtents[3]);
+        }
+
+        for (const auto atom : state) {
+            winProperties.state |= netState(atom);
+        }
+
+        if (!desktop.isEmpty()) {
+            //! NET desktops are counted from 1, 0xFFFFFFFF means all desktops
+            winProperties.desktop = (desktop[0] == 0xFFFFFFFF) ? NET::OnAllDesktops : (int)desktop[0] + 1;
+        }
+
+        winProperties.isDesktopType = windowType.contains(m_atoms[AtomNetWmWindowTypeDesktop]);
+
+        //! the null activity id means all activities
+        for (const auto &activity : activities.split(',')) {
+            if (activity == QByteArrayLiteral("00000000-0000-0000-0000-000000000000")) {
+                winProperties.activities.clear();
+                break;
+            } else if (!activity.isEmpty()) {
+                winProperties.activities << QString::fromLatin1(activity);
+            }
+        }
+
+        //! WM_CLASS is the instance name followed by the class name
+        winProperties.windowClassName = windowClass.left(windowClass.indexOf('\0'));
+
+        if (allowedActionsSupported) {
+            for (const auto atom : allowedActions) {
+                winProperties.allowedActions |= netAction(atom);
+            }
+        } else {
+            winProperties.allowedActions = NET::Actions(~0);
+        }
+
+        if (!transientFor.isEmpty()) {
+            winProperties.transientFor = transientFor[0];
+        }
+
+        if (!visibleName.isEmpty()) {
+            winProperties.visibleName = QString::fromUtf8(visibleName);
+        } else if (!name.isEmpty()) {
+            winProperties.visibleName = QString::fromUtf8(name);
+        } else {
+            winProperties.visibleName = QString::fromLocal8Bit(wmName);
+        }
+
+        properties << winProperties;
+    }
+
+    return properties;
+}
+
+XWindowInterface::WindowProperties XWindowInterface::windowPropertiesFromKWindowInfo(WindowId wid)
+{
+    const KWindowInfo winfo{wid.value<WId>(), NET::WMFrameExtents
+                | NET::WMWindowType
+                | NET::WMGeometry
+                | NET::WMDesktop
+                | NET::WMState
+                | NET::WMName
+                | NET::WMVisibleName,
+                NET::WM2WindowClass
+                | NET::WM2Activities
+                | NET::WM2AllowedActions
+                | NET::WM2TransientFor};
+
+    WindowProperties properties;
+
+    if (!winfo.valid()) {
+        return properties;
+    }
+
+    const QList<NET::Action> actions{NET::ActionClose, NET::ActionFullScreen, NET::ActionMaxVert, NET::ActionMaxHoriz,
+                NET::ActionMinimize, NET::ActionMove, NET::ActionResize, NET::ActionShade, NET::ActionChangeDesktop};
+
+    properties.valid = true;
+    properties.isDesktopType = (winfo.windowType(NET::DesktopMask) == NET::Desktop);
+    properties.desktop = winfo.desktop();
+    properties.transientFor = winfo.transientFor();
+    properties.state = winfo.state();
+    properties.geometry = winfo.geometry();
+    properties.frameGeometry = winfo.frameGeometry();
+    properties.windowClassName = winfo.windowClassName();
+    properties.visibleName = winfo.visibleName();
+    properties.activities = winfo.activities();
+
+    for (const auto action : actions) {
+        if (winfo.actionSupported(action)) {
+            properties.allowedActions |= action;
+        }
+    }
+
+    return properties;
+}
 
 
 void XWindowInterface::setFrameExtents(QWindow *view, const QMargins &margins)
@@ -443,66 +780,87 @@ WindowInfoWrap XWindowInterface::requestInfoActive()
 
 WindowInfoWrap XWindowInterface::requestInfo(WindowId wid)
 {
-    const KWindowInfo winfo{wid.value<WId>(), NET::WMFrameExtents
-                | NET::WMWindowType
-                | NET::WMGeometry
-                | NET::WMDesktop
-                | NET::WMState
-                | NET::WMName
-                | NET::WMVisibleName,
-                NET::WM2WindowClass
-                | NET::WM2Activities
-                | NET::WM2AllowedActions
-                | NET::WM2TransientFor};
+    return requestInfoBatch(QList<WindowId>() << wid).first();
+}
+
+QList<WindowInfoWrap> XWindowInterface::requestInfoBatch(const QList<WindowId> &wids)
+{
+    QList<WindowInfoWrap> infos;
+
+    if (wids.isEmpty()) {
+        return infos;
+    }
+
+    QList<WindowProperties> properties;
 
+    if (internAtoms()) {
+        properties = windowProperties(wids);
+    } else {
+        for (const auto &wid : wids) {
+            properties << windowPropertiesFromKWindowInfo(wid);
+        }
+    }
+
+    const WId activeWindow = KWindowSystem::activeWindow();
+
+    for (int i=0; i<wids.count(); ++i) {
+        infos << requestInfo(wids[i], activeWindow, properties[i]);
+    }
+
+    return infos;
+}
+
+WindowInfoWrap XWindowInterface::requestInfo(WindowId wid, WId activeWindow, const WindowProperties &properties)
+{
     WindowInfoWrap winfoWrap;
 
-    const auto winClass = QString(winfo.windowClassName());
+    const auto winClass = QString(properties.windowClassName);
 
     //!used to track Plasma DesktopView windows because during startup can not be identified properly
-    bool plasmaBlockedWindow = (winClass == QLatin1String("plasmashell") && !isAcceptableWindow(wid));
+    bool plasmaBlockedWindow = (winClass == QLatin1String("plasmashell")
+                                && (properties.isDesktopType || !isAcceptableWindow(wid, properties)));
 
-    if (!winfo.valid() || plasmaBlockedWindow) {
+    if (!properties.valid || plasmaBlockedWindow) {
         winfoWrap.setIsValid(false);
-    } else if (isValidWindow(wid)) {
+    } else if (isValidWindow(wid, properties)) {
         winfoWrap.setIsValid(true);
         winfoWrap.setWid(wid);
-        winfoWrap.setParentId(winfo.transientFor());
-        winfoWrap.setIsActive(KWindowSystem::activeWindow() == wid.value<WId>());
-        winfoWrap.setIsMinimized(winfo.hasState(NET::Hidden));
-        winfoWrap.setIsMaxVert(winfo.hasState(NET::MaxVert));
-        winfoWrap.setIsMaxHoriz(winfo.hasState(NET::MaxHoriz));
-        winfoWrap.setIsFullscreen(winfo.hasState(NET::FullScreen));
-        winfoWrap.setIsShaded(winfo.hasState(NET::Shaded));
-        winfoWrap.setIsOnAllDesktops(winfo.onAllDesktops());
-        winfoWrap.setIsOnAllActivities(winfo.activities().empty());
+        winfoWrap.setParentId(properties.transientFor);
+        winfoWrap.setIsActive(activeWindow == wid.value<WId>());
+        winfoWrap.setIsMinimized(properties.state.testFlag(NET::Hidden));
+        winfoWrap.setIsMaxVert(properties.state.testFlag(NET::MaxVert));
+        winfoWrap.setIsMaxHoriz(properties.state.testFlag(NET::MaxHoriz));
+        winfoWrap.setIsFullscreen(properties.state.testFlag(NET::FullScreen));
+        winfoWrap.setIsShaded(properties.state.testFlag(NET::Shaded));
+        winfoWrap.setIsOnAllDesktops(properties.desktop == NET::OnAllDesktops);
+        winfoWrap.setIsOnAllActivities(properties.activities.empty());
 #if KF5_VERSION_MINOR >= 65
-        winfoWrap.setGeometry(visibleGeometry(wid, winfo.frameGeometry()));
+        winfoWrap.setGeometry(properties.gtkFrameExtents.isNull() ? properties.frameGeometry : properties.frameGeometry - properties.gtkFrameExtents);
 #else
-        winfoWrap.setGeometry(winfo.frameGeometry());
+        winfoWrap.setGeometry(properties.frameGeometry);
 #endif
-        winfoWrap.setIsKeepAbove(winfo.hasState(NET::KeepAbove));
-        winfoWrap.setIsKeepBelow(winfo.hasState(NET::KeepBelow));
-        winfoWrap.setHasSkipPager(winfo.hasState(NET::SkipPager));
+        winfoWrap.setIsKeepAbove(properties.state.testFlag(NET::KeepAbove));
+        winfoWrap.setIsKeepBelow(properties.state.testFlag(NET::KeepBelow));
+        winfoWrap.setHasSkipPager(properties.state.testFlag(NET::SkipPager));
 #if KF5_VERSION_MINOR >= 45
-        winfoWrap.setHasSkipSwitcher(winfo.hasState(NET::SkipSwitcher));
+        winfoWrap.setHasSkipSwitcher(properties.state.testFlag(NET::SkipSwitcher));
 #endif
-        winfoWrap.setHasSkipTaskbar(winfo.hasState(NET::SkipTaskbar));
+        winfoWrap.setHasSkipTaskbar(properties.state.testFlag(NET::SkipTaskbar));
 
         //! BEGIN:Window Abilities
-        winfoWrap.setIsClosable(winfo.actionSupported(NET::ActionClose));
-        winfoWrap.setIsFullScreenable(winfo.actionSupported(NET::ActionFullScreen));
-        winfoWrap.setIsMaximizable(winfo.actionSupported(NET::ActionMax));
-        winfoWrap.setIsMinimizable(winfo.actionSupported(NET::ActionMinimize));
-        winfoWrap.setIsMovable(winfo.actionSupported(NET::ActionMove));
-        winfoWrap.setIsResizable(winfo.actionSupported(NET::ActionResize));
-        winfoWrap.setIsShadeable(winfo.actionSupported(NET::ActionShade));
-        winfoWrap.setIsVirtualDesktopsChangeable(winfo.actionSupported(NET::ActionChangeDesktop));
+        winfoWrap.setIsClosable(properties.allowedActions & NET::ActionClose);
+        winfoWrap.setIsFullScreenable(properties.allowedActions & NET::ActionFullScreen);
+        winfoWrap.setIsMaximizable(properties.allowedActions & NET::ActionMax);
+        winfoWrap.setIsMinimizable(properties.allowedActions & NET::ActionMinimize);
+        winfoWrap.setIsMovable(properties.allowedActions & NET::ActionMove);
+        winfoWrap.setIsResizable(properties.allowedActions & NET::ActionResize);
+        winfoWrap.setIsShadeable(properties.allowedActions & NET::ActionShade);
+        winfoWrap.setIsVirtualDesktopsChangeable(properties.allowedActions & NET::ActionChangeDesktop);
         //! END:Window Abilities
 
-        winfoWrap.setDisplay(winfo.visibleName());
-        winfoWrap.setDesktops({QString(winfo.desktop())});
-        winfoWrap.setActivities(winfo.activities());
+        winfoWrap.setDisplay(properties.visibleName);
+        winfoWrap.setDesktops({QString(properties.desktop)});
+        winfoWrap.setActivities(properties.activities);
     }
 
     if (plasmaBlockedWindow) {
@@ -517,39 +875,22 @@ AppData XWindowInterface::appDataFor(WindowId wid)
     return appDataFromUrl(windowUrl(wid));
 }
 
-QUrl XWindowInterface::windowUrl(WindowId wid)
+AppMetadata XWindowInterface::appMetadataFor(WindowId wid)
 {
     const KWindowInfo info(wid.value<WId>(), 0, NET::WM2WindowClass | NET::WM2DesktopFileName);
 
-    QString desktopFile = QString::fromUtf8(info.desktopFileName());
-
-    if (!desktopFile.isEmpty()) {
-        KService::Ptr service = KService::serviceByStorageId(desktopFile);
-
-        if (service) {
-            const QString &menuId = service->menuId();
+    AppMetadata metadata;
+    metadata.appId = QString::fromUtf8(info.windowClassClass());
+    metadata.wmClassName = QString::fromUtf8(info.windowClassName());
+    metadata.desktopFileName = QString::fromUtf8(info.desktopFileName());
+    metadata.pid = NETWinInfo(QX11Info::connection(), wid.value<WId>(), QX11Info::appRootWindow(), NET::WMPid, NET::Properties2()).pid();
 
-            // applications: URLs are used to refer to applications by their KService::menuId
-            // (i.e. .desktop file name) rather than the absolute path to a .desktop file.
-            if (!menuId.isEmpty()) {
-                return QUrl(QStringLiteral("applications:") + menuId);
-            }
-
-            return QUrl::fromLocalFile(service->entryPath());
-        }
-
-        if (!desktopFile.endsWith(QLatin1String(".desktop"))) {
-            desktopFile.append(QLatin1String(".desktop"));
-        }
-
-        if (KDesktopFile::isDesktopFile(desktopFile) && QFile::exists(desktopFile)) {
-            return QUrl::fromLocalFile(desktopFile);
-        }
-    }
+    return metadata;
+}
 
-    return windowUrlFromMetadata(info.windowClassClass(),
-                                 NETWinInfo(QX11Info::connection(), wid.value<WId>(), QX11Info::appRootWindow(), NET::WMPid, NET::Properties2()).pid(),
-                                 rulesConfig, info.windowClassName());
+QUrl XWindowInterface::windowUrl(WindowId wid)
+{
+    return AppDataResolver::windowUrl(appMetadataFor(wid), rulesConfig);
 }
 
 bool XWindowInterface::windowCanBeDragged(WindowId wid)
@@ -754,11 +1095,32 @@ bool XWindowInterface::isValidWindow(WindowId wid)
     return isAcceptableWindow(wid);
 }
 
+bool XWindowInterface::isValidWindow(WindowId wid, const WindowProperties &properties)
+{
+    if (windowsTracker()->isValidFor(wid)) {
+        return true;
+    }
+
+    return isAcceptableWindow(wid, properties);
+}
+
 bool XWindowInterface::isAcceptableWindow(WindowId wid)
 {
     const KWindowInfo info(wid.toUInt(), NET::WMGeometry | NET::WMState, NET::WM2WindowClass);
 
-    const auto winClass = QString(info.windowClassName());
+    WindowProperties properties;
+    properties.valid = info.valid();
+    properties.state = info.state();
+    properties.geometry = info.geometry();
+    properties.windowClassName = info.windowClassName();
+
+    return isAcceptableWindow(wid, properties);
+}
+
+//! properties must provide at least the geometry, the state and the window class
+bool XWindowInterface::isAcceptableWindow(WindowId wid, const WindowProperties &properties)
+{
+    const auto winClass = QString(properties.windowClassName);
 
     //! ignored windows do not trackd
     if (hasBlockedTracking(wid)) {
@@ -771,8 +1133,8 @@ bool XWindowInterface::isAcceptableWindow(WindowId wid)
     }
 
     //! Window Checks
-    bool hasSkipTaskbar = info.hasState(NET::SkipTaskbar);
-    bool hasSkipPager = info.hasState(NET::SkipPager);
+    bool hasSkipTaskbar = properties.state.testFlag(NET::SkipTaskbar);
+    bool hasSkipPager = properties.state.testFlag(NET::SkipPager);
     bool isSkipped = hasSkipTaskbar && hasSkipPager;
 
     if (isSkipped
@@ -780,16 +1142,16 @@ bool XWindowInterface::isAcceptableWindow(WindowId wid)
                  || (winClass == QLatin1String("krunner"))) )) {
         registerWhitelistedWindow(wid);
     } else if (winClass == QLatin1String("plasmashell")) {
-        if (isSkipped && isSidepanel(info.geometry())) {
+        if (isSkipped && isSidepanel(properties.geometry)) {
             registerWhitelistedWindow(wid);
             return true;
-        } else if (isPlasmaPanel(info.geometry()) || isFullScreenWindow(info.geometry())) {
+        } else if (isPlasmaPanel(properties.geometry) || isFullScreenWindow(properties.geometry)) {
             registerPlasmaIgnoredWindow(wid);
             return false;
         }
     } else if ((winClass == QLatin1String("latte-dock"))
                || (winClass == QLatin1String("ksmserver"))) {
-        if (isFullScreenWindow(info.geometry())) {
+        if (isFullScreenWindow(properties.geometry)) {
             registerIgnoredWindow(wid);
             return false;
         }
@@ -834,7 +1196,37 @@ void XWindowInterface::windowChangedProxy(WId wid, NET::Properties prop1, NET::P
         return;
     }
 
-    considerWindowChanged(wid);
+    int changes{NoChange};
+
+    if (prop1 & NET::WMState) {
+        changes |= StateChange;
+    }
+
+    if (prop1 & NET::WMGeometry) {
+        changes |= GeometryChange;
+    }
+
+    if (prop1 & NET::ActiveWindow) {
+        changes |= ActiveChange;
+    }
+
+    if (prop1 & NET::WMDesktop) {
+        changes |= DesktopChange;
+    }
+
+    if (prop1 & (NET::WMName | NET::WMVisibleName)) {
+        changes |= NameChange;
+    }
+
+    if (prop2 & NET::WM2Activities) {
+        changes |= ActivitiesChange;
+    }
+
+    if (prop2 & NET::WM2TransientFor) {
+        changes |= ParentChange;
+    }
+
+    considerWindowChanged(wid, changes);
 }
 
 }
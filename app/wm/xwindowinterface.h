@@ -28,11 +28,15 @@
 
 // Qt
 #include <QObject>
+#include <QVector>
 
 // KDE
 #include <KWindowInfo>
 #include <KWindowEffects>
 
+// X11
+#include <xcb/xcb.h>
+
 
 namespace Latte {
 namespace WindowSystem {
@@ -54,6 +58,9 @@ public:
     WindowId activeWindow() override;
     WindowInfoWrap requestInfo(WindowId wid) override;
     WindowInfoWrap requestInfoActive() override;
+    //! the properties requests of all windows are pipelined through xcb,
+    //! KWindowInfo is used only when the needed atoms are not available
+    QList<WindowInfoWrap> requestInfoBatch(const QList<WindowId> &wids) override;
 
     void skipTaskBar(const QDialog &dialog) override;
     void slideWindow(QWindow &view, Slide location) override;
@@ -76,6 +83,7 @@ public:
     WindowId winIdFor(QString appId, QRect geometry) override;
     WindowId winIdFor(QString appId, QString title) override;
     AppData appDataFor(WindowId wid) override;
+    AppMetadata appMetadataFor(WindowId wid) override;
 
     void setActiveEdge(QWindow *view, bool active) override;
 
@@ -86,12 +94,71 @@ public:
     void setInputMask(QWindow *window, const QRect &rect) override;
 
 private:
+    //! window properties that are needed in order to track a window
+    struct WindowProperties {
+        bool valid{false};
+        bool isDesktopType{false};
+        int desktop{0};
+        WId transientFor{0};
+        NET::States state;
+        NET::Actions allowedActions;
+        QRect geometry;
+        QRect frameGeometry;
+        QMargins gtkFrameExtents;
+        QByteArray windowClassName;
+        QString visibleName;
+        QStringList activities;
+    };
+
+    //! must follow the ATOMNAMES order
+    enum XcbAtom {
+        AtomNetWmState = 0,
+        AtomNetWmDesktop,
+        AtomNetWmWindowType,
+        AtomNetWmWindowTypeDesktop,
+        AtomNetFrameExtents,
+        AtomGtkFrameExtents,
+        AtomKdeNetWmActivities,
+        AtomNetWmAllowedActions,
+        AtomNetWmName,
+        AtomNetWmVisibleName,
+        AtomUtf8String,
+        AtomStateHidden,
+        AtomStateMaxVert,
+        AtomStateMaxHoriz,
+        AtomStateFullScreen,
+        AtomStateShaded,
+        AtomStateKeepAbove,
+        AtomStateKeepBelow,
+        AtomStateSkipPager,
+        AtomStateSkipTaskbar,
+        AtomStateSkipSwitcher,
+        AtomActionClose,
+        AtomActionFullScreen,
+        AtomActionMaxVert,
+        AtomActionMaxHoriz,
+        AtomActionMinimize,
+        AtomActionMove,
+        AtomActionResize,
+        AtomActionShade,
+        AtomActionChangeDesktop,
+        AtomsCount
+    };
+
     bool isAcceptableWindow(WindowId wid);
+    bool isAcceptableWindow(WindowId wid, const WindowProperties &properties);
     bool isValidWindow(WindowId wid);
+    bool isValidWindow(WindowId wid, const WindowProperties &properties);
+
+    bool internAtoms();
+    NET::States netState(xcb_atom_t atom) const;
+    NET::Actions netAction(xcb_atom_t atom) const;
 
-#if KF5_VERSION_MINOR >= 65
-    QRect visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const;
-#endif
+    WindowInfoWrap requestInfo(WindowId wid, WId activeWindow, const WindowProperties &properties);
+
+    //! all properties requests are sent first and their replies are collected afterwards
+    QList<WindowProperties> windowProperties(const QList<WindowId> &wids);
+    WindowProperties windowPropertiesFromKWindowInfo(WindowId wid);
 
     void windowAddedProxy(WId wid);
     void windowChangedProxy(WId wid, NET::Properties prop1, NET::Properties2 prop2);
@@ -104,6 +171,9 @@ private:
     //xcb_shape
     bool m_shapeExtensionChecked{false};
     bool m_shapeAvailable{false};
+
+    //! empty until all atoms are interned
+    QVector<xcb_atom_t> m_atoms;
 };
 
 }
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "commontools.h"
+
+// Qt
+#include <QElapsedTimer>
+#include <QImage>
+#include <QtTest>
+
+// C++
+#include <functional>
+
+//! Verifies the vectorized brightness and dominant color kernels against
+//! plain per-pixel loops and reports their throughput per megapixel
+class CommonToolsBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void areaBrightness_data();
+    void areaBrightness();
+    void weightedAverageColor_data();
+    void weightedAverageColor();
+
+    void areaBrightnessThroughput();
+    void weightedAverageColorThroughput();
+
+private:
+    static QImage noiseImage(const QSize &size, QImage::Format format = QImage::Format_ARGB32);
+    //! forces the requested kernels, returns false when they are not supported
+    static bool useKernels(bool avx2);
+    static QRgb storedPixel(const QImage &image, int col, int row);
+    static void reportThroughput(const char *kernel, const QImage &image, const std::function<void()> &run);
+
+    static float scalarAreaBrightness(const QImage &image, const QRect &area);
+    static QColor scalarWeightedAverageColor(const QImage &image);
+
+private:
+    QImage m_wallpaper;
+};
+
+QImage CommonToolsBenchmark::noiseImage(const QSize &size, QImage::Format format)
+{
+    QImage image(size, QImage::Format_ARGB32);
+    quint32 seed{1};
+
+    for (int row = 0; row < image.height(); ++row) {
+        QRgb *line = (QRgb *)image.scanLine(row);
+
+        for (int col = 0; col < image.width(); ++col) {
+            seed = seed * 1664525u + 1013904223u;
+            line[col] = seed;
+        }
+    }
+
+    return image.convertToFormat(format);
+}
+
+bool CommonToolsBenchmark::useKernels(bool avx2)
+{
+    return (Latte::setAvx2KernelsEnabled(avx2) == avx2);
+}
+
+//! kernels read 32bit pixels as they are stored, premultiplied ones included
+QRgb CommonToolsBenchmark::storedPixel(const QImage &image, int col, int row)
+{
+    return ((const QRgb *)image.constScanLine(row))[col];
+}
+
+float CommonToolsBenchmark::scalarAreaBrightness(const QImage &image, const QRect &area)
+{
+    qreal sum{0};
+
+    for (int row = area.top(); row <= area.bottom(); ++row) {
+        for (int col = area.left(); col <= area.right(); ++col) {
+            sum += Latte::colorBrightness(storedPixel(image, col, row));
+        }
+    }
+
+    return (float)(sum / ((qreal)area.width() * area.height()));
+}
+
+QColor CommonToolsBenchmark::scalarWeightedAverageColor(const QImage &image)
+{
+    qreal rtotal{0}, gtotal{0}, btotal{0}, total{0};
+
+    for (int row = 0; row < image.height(); ++row) {
+        for (int col = 0; col < image.width(); ++col) {
+            const QRgb pix = storedPixel(image, col, row);
+
+            int r = qRed(pix);
+            int g = qGreen(pix);
+            int b = qBlue(pix);
+
+            qreal saturation = (qMax(r, qMax(g, b)) - qMin(r, qMin(g, b))) / 255.0;
+            qreal relevance = .1 + .9 * (qAlpha(pix) / 255.0) * saturation;
+
+            rtotal += r * relevance;
+            gtotal += g * relevance;
+            btotal += b * relevance;
+            total += relevance;
+        }
+    }
+
+    return QColor((int)(rtotal / total), (int)(gtotal / total), (int)(btotal / total));
+}
+
+void CommonToolsBenchmark::reportThroughput(const char *kernel, const QImage &image, const std::function<void()> &run)
+{
+    const int runs{20};
+    const qreal megapixels = (qreal)image.width() * image.height() / 1000000;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < runs; ++i) {
+        run();
+    }
+
+    const qreal msecs = (qreal)timer.nsecsElapsed() / 1000000 / runs;
+
+    qInfo("%s: %.3f ms per megapixel, %.1f megapixels per second",
+          kernel, msecs / megapixels, (megapixels * 1000) / qMax(msecs, 0.001));
+}
+
+void CommonToolsBenchmark::initTestCase()
+{
+    m_wallpaper = noiseImage(QSize(1920, 1080));
+}
+
+void CommonToolsBenchmark::cleanup()
+{
+    Latte::setAvx2KernelsEnabled(true);
+}
+
+void CommonToolsBenchmark::areaBrightness_data()
+{
+    QTest::addColumn<bool>("avx2");
+    QTest::addColumn<int>("format");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<QRect>("area");
+
+    for (const bool avx2 : {true, false}) {
+        const QByteArray kernels = avx2 ? "avx2" : "sse2";
+
+        //! odd widths and offsets exercise the scalar tails of the kernels
+        QTest::newRow((kernels + " full").constData()) << avx2 << (int)QImage::Format_ARGB32 << QSize(640, 480) << QRect(0, 0, 640, 480);
+        QTest::newRow((kernels + " edge band").constData()) << avx2 << (int)QImage::Format_ARGB32 << QSize(641, 480) << QRect(0, 470, 641, 10);
+        QTest::newRow((kernels + " unaligned").constData()) << avx2 << (int)QImage::Format_ARGB32 << QSize(333, 77) << QRect(3, 5, 301, 61);
+        QTest::newRow((kernels + " premultiplied").constData()) << avx2 << (int)QImage::Format_ARGB32_Premultiplied << QSize(333, 77) << QRect(3, 5, 301, 61);
+    }
+}
+
+void CommonToolsBenchmark::areaBrightness()
+{
+    QFETCH(bool, avx2);
+    QFETCH(int, format);
+    QFETCH(QSize, size);
+    QFETCH(QRect, area);
+
+    if (!useKernels(avx2)) {
+        QSKIP("AVX2 kernels are not supported");
+    }
+
+    const QImage image = noiseImage(size, (QImage::Format)format);
+
+    QVERIFY(qAbs(Latte::areaBrightness(image, area) - scalarAreaBrightness(image, area)) < 0.01);
+}
+
+void CommonToolsBenchmark::weightedAverageColor_data()
+{
+    QTest::addColumn<bool>("avx2");
+    QTest::addColumn<int>("format");
+    QTest::addColumn<QSize>("size");
+
+    for (const bool avx2 : {true, false}) {
+        const QByteArray kernels = avx2 ? "avx2" : "sse2";
+
+        QTest::newRow((kernels + " icon").constData()) << avx2 << (int)QImage::Format_ARGB32 << QSize(64, 64);
+        QTest::newRow((kernels + " unaligned").constData()) << avx2 << (int)QImage::Format_ARGB32 << QSize(67, 13);
+        QTest::newRow((kernels + " premultiplied").constData()) << avx2 << (int)QImage::Format_ARGB32_Premultiplied << QSize(67, 13);
+    }
+}
+
+void CommonToolsBenchmark::weightedAverageColor()
+{
+    QFETCH(bool, avx2);
+    QFETCH(int, format);
+    QFETCH(QSize, size);
+
+    if (!useKernels(avx2)) {
+        QSKIP("AVX2 kernels are not supported");
+    }
+
+    const QImage image = noiseImage(size, (QImage::Format)format);
+    const QColor color = Latte::weightedAverageColor(image);
+    const QColor expected = scalarWeightedAverageColor(image);
+
+    //! float sums of the kernels are rounded differently than the reference
+    QVERIFY(qAbs(color.red() - expected.red()) <= 1);
+    QVERIFY(qAbs(color.green() - expected.green()) <= 1);
+    QVERIFY(qAbs(color.blue() - expected.blue()) <= 1);
+}
+
+void CommonToolsBenchmark::areaBrightnessThroughput()
+{
+    const QImage &image = m_wallpaper;
+
+    reportThroughput("areaBrightness", image, [&image]() {
+        Latte::areaBrightness(image, image.rect());
+    });
+
+    QBENCHMARK {
+        Latte::areaBrightness(image, image.rect());
+    }
+}
+
+void CommonToolsBenchmark::weightedAverageColorThroughput()
+{
+    const QImage &image = m_wallpaper;
+
+    reportThroughput("weightedAverageColor", image, [&image]() {
+        Latte::weightedAverageColor(image);
+    });
+
+    QBENCHMARK {
+        Latte::weightedAverageColor(image);
+    }
+}
+
+QTEST_GUILESS_MAIN(CommonToolsBenchmark)
+
+#include "commontoolsbenchmark.moc"
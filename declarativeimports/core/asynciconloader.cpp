@@ -0,0 +1,196 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "asynciconloader.h"
+
+// local
+#include "iconitem.h"
+
+// Qt
+#include <QDebug>
+#include <QRunnable>
+
+// KDE
+#include <KIconTheme>
+#include <KIconThemes/KIconLoader>
+
+#define MAXLOADINGTHREADS 2
+
+namespace Latte {
+
+class IconLoadingJob : public QRunnable
+{
+public:
+    IconLoadingJob(AsyncIconLoader *loader, const QString &key, QSharedPointer<QAtomicInt> cancelled,
+                   const QString &themeName, const QString &iconName, const QString &file, int size)
+        : m_loader(loader),
+          m_cancelled(cancelled),
+          m_key(key),
+          m_themeName(themeName),
+          m_iconName(iconName),
+          m_file(file),
+          m_size(size)
+    {
+    }
+
+    void run() override
+    {
+        if (m_cancelled->load()) {
+            return;
+        }
+
+        QString path;
+        QImage image;
+
+        if (!m_iconName.isEmpty()) {
+            path = AsyncIconLoader::themeIconPath(m_themeName, m_iconName, m_size);
+        } else {
+            path = m_file;
+            image = QImage(m_file);
+        }
+
+        emit m_loader->jobFinished(m_key, path, image);
+    }
+
+private:
+    AsyncIconLoader *m_loader{nullptr};
+    QSharedPointer<QAtomicInt> m_cancelled;
+
+    QString m_key;
+    QString m_themeName;
+    QString m_iconName;
+    QString m_file;
+    int m_size{0};
+};
+
+AsyncIconLoader::AsyncIconLoader(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(MAXLOADINGTHREADS);
+
+    connect(this, &AsyncIconLoader::jobFinished, this, &AsyncIconLoader::onJobFinished, Qt::QueuedConnection);
+}
+
+AsyncIconLoader::~AsyncIconLoader()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+AsyncIconLoader *AsyncIconLoader::self()
+{
+    static AsyncIconLoader loader;
+    return &loader;
+}
+
+QString AsyncIconLoader::requestIconPath(IconItem *waiter, const QString &iconName, int size)
+{
+    const auto *iconTheme = KIconLoader::global()->theme();
+
+    if (!iconTheme) {
+        qWarning() << "KIconLoader has no theme set";
+        return QString();
+    }
+
+    const QString themeName = iconTheme->internalName();
+    const QString key = QStringLiteral("icon:") + themeName + QLatin1Char(':') + QString::number(size) + QLatin1Char(':') + iconName;
+
+    return request(waiter, key, themeName, iconName, QString(), size);
+}
+
+QString AsyncIconLoader::requestImage(IconItem *waiter, const QString &file)
+{
+    return request(waiter, QStringLiteral("file:") + file, QString(), QString(), file, 0);
+}
+
+QString AsyncIconLoader::request(IconItem *waiter, const QString &key, const QString &themeName, const QString &iconName, const QString &file, int size)
+{
+    if (m_requests.contains(key)) {
+        m_requests[key].waiters << waiter;
+        return key;
+    }
+
+    Request &request = m_requests[key];
+    request.waiters << waiter;
+    request.cancelled = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+
+    m_pool.start(new IconLoadingJob(this, key, request.cancelled, themeName, iconName, file, size));
+
+    return key;
+}
+
+void AsyncIconLoader::cancel(IconItem *waiter, const QString &key)
+{
+    if (!m_requests.contains(key)) {
+        return;
+    }
+
+    Request &request = m_requests[key];
+    request.waiters.removeOne(waiter);
+    //! waiters that were destroyed without cancelling
+    request.waiters.removeAll(nullptr);
+
+    if (request.waiters.isEmpty()) {
+        //! jobs that are already running are not interrupted, their results are ignored
+        request.cancelled->store(1);
+        m_requests.remove(key);
+    }
+}
+
+void AsyncIconLoader::onJobFinished(const QString &key, const QString &path, const QImage &image)
+{
+    if (!m_requests.contains(key)) {
+        return;
+    }
+
+    const QList<QPointer<IconItem>> waiters = m_requests.take(key).waiters;
+
+    for (const auto &waiter : waiters) {
+        if (waiter) {
+            waiter->onAsyncIconLoaded(key, path, image);
+        }
+    }
+}
+
+QString AsyncIconLoader::themeIconPath(const QString &themeName, const QString &iconName, int size)
+{
+    //! KIconLoader is not thread safe, every worker thread uses its own icon theme
+    static thread_local QHash<QString, QSharedPointer<KIconTheme>> themes;
+
+    if (!themes.contains(themeName)) {
+        themes[themeName] = QSharedPointer<KIconTheme>(new KIconTheme(themeName));
+    }
+
+    const QSharedPointer<KIconTheme> &theme = themes[themeName];
+
+    if (!theme->isValid()) {
+        return QString();
+    }
+
+    QString iconPath = theme->iconPath(iconName + QLatin1String(".svg"), size, KIconLoader::MatchBest);
+
+    if (iconPath.isEmpty()) {
+        iconPath = theme->iconPath(iconName + QLatin1String(".svgz"), size, KIconLoader::MatchBest);
+    }
+
+    return iconPath;
+}
+
+}
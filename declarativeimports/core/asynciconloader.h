@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATTEASYNCICONLOADER_H
+#define LATTEASYNCICONLOADER_H
+
+// Qt
+#include <QAtomicInt>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QThreadPool>
+
+namespace Latte {
+class IconItem;
+}
+
+namespace Latte {
+
+//! Resolves icon theme paths and decodes image files in worker threads for
+//! IconItems that are loaded asynchronously. Identical requests are merged
+//! and requests that nobody waits for are cancelled before they run. Only the
+//! IconItems that wait for a request are informed when it is loaded.
+class AsyncIconLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AsyncIconLoader *self();
+    ~AsyncIconLoader() override;
+
+    //! the returned keys identify the requests in IconItem::onAsyncIconLoaded,
+    //! path is empty when the icon was not found in the icon theme
+    QString requestIconPath(IconItem *waiter, const QString &iconName, int size);
+    QString requestImage(IconItem *waiter, const QString &file);
+
+    //! the waiter is not interested any more for that request
+    void cancel(IconItem *waiter, const QString &key);
+
+signals:
+    //! emitted from worker threads
+    void jobFinished(const QString &key, const QString &path, const QImage &image);
+
+private slots:
+    void onJobFinished(const QString &key, const QString &path, const QImage &image);
+
+private:
+    AsyncIconLoader(QObject *parent = nullptr);
+
+    QString request(IconItem *waiter, const QString &key, const QString &themeName, const QString &iconName, const QString &file, int size);
+
+    //! it is used from worker threads
+    static QString themeIconPath(const QString &themeName, const QString &iconName, int size);
+
+private:
+    struct Request {
+        QList<QPointer<IconItem>> waiters;
+        QSharedPointer<QAtomicInt> cancelled;
+    };
+
+    QHash<QString, Request> m_requests;
+    QThreadPool m_pool;
+
+    friend class IconLoadingJob;
+};
+
+}
+
+#endif
@@ -23,7 +23,10 @@
 #include "iconitem.h"
 
 // local
+#include "asynciconloader.h"
 #include "extras.h"
+#include "iconregistry.h"
+#include "../../app/tools/commontools.h"
 
 // Qt
 #include <QDebug>
@@ -39,8 +42,32 @@
 #include <KIconThemes/KIconLoader>
 #include <KIconThemes/KIconEffect>
 
+//! rasterized sizes and state variants that are kept for each icon
+#define MAXCACHEDPIXMAPS 8
+//! the icon size is considered at rest when it has not changed for that interval
+#define SIZERESTINTERVAL 250
+//! icon colors are calculated from an icon version that is not bigger than that
+#define MAXCOLORSLENGTH 32
+
 namespace Latte {
 
+namespace {
+//! pixel sizes used while the icon size is changing, the icon is drawn scaled
+//! down from the closest bigger bucket
+int sizeBucket(int size)
+{
+    static const QList<int> buckets{16, 22, 32, 48, 64, 96, 128, 192, 256};
+
+    for (const auto bucket : buckets) {
+        if (size <= bucket) {
+            return bucket;
+        }
+    }
+
+    return ((size + 127) / 128) * 128;
+}
+}
+
 IconItem::IconItem(QQuickItem *parent)
     : QQuickItem(parent),
       m_lastValidSourceName(QString()),
@@ -56,6 +83,10 @@ IconItem::IconItem(QQuickItem *parent)
             this, SIGNAL(implicitWidthChanged()));
     connect(KIconLoader::global(), SIGNAL(iconLoaderSettingsChanged()),
             this, SIGNAL(implicitHeightChanged()));
+    connect(KIconLoader::global(), &KIconLoader::iconLoaderSettingsChanged,
+            this, &IconItem::schedulePixmapUpdate);
+    connect(IconRegistry::self(), &IconRegistry::iconsInvalidated,
+            this, &IconItem::schedulePixmapUpdate);
     connect(this, &QQuickItem::enabledChanged,
             this, &IconItem::enabledChanged);
     connect(this, &QQuickItem::windowChanged,
@@ -65,6 +96,12 @@ IconItem::IconItem(QQuickItem *parent)
     connect(this, SIGNAL(providesColorsChanged()),
             this, SLOT(schedulePixmapUpdate()));
 
+    m_sizeRestTimer.setInterval(SIZERESTINTERVAL);
+    m_sizeRestTimer.setSingleShot(true);
+    connect(&m_sizeRestTimer, &QTimer::timeout, this, [&]() {
+        polish();
+    });
+
     //initialize implicit size to the Dialog size
     setImplicitWidth(KIconLoader::global()->currentSize(KIconLoader::Dialog));
     setImplicitHeight(KIconLoader::global()->currentSize(KIconLoader::Dialog));
@@ -73,6 +110,8 @@ IconItem::IconItem(QQuickItem *parent)
 
 IconItem::~IconItem()
 {
+    cancelAsyncRequest();
+    clearPixmapCache();
 }
 
 void IconItem::setSource(const QVariant &source)
@@ -84,6 +123,9 @@ void IconItem::setSource(const QVariant &source)
     m_source = source;
     QString sourceString = source.toString();
 
+    //! a newer source is replacing the one that was still loading
+    cancelAsyncRequest();
+
     // If the QIcon was created with QIcon::fromTheme(), try to load it as svg
     if (source.canConvert<QIcon>() && !source.value<QIcon>().name().isEmpty()) {
         sourceString = source.value<QIcon>().name();
@@ -96,32 +138,40 @@ void IconItem::setSource(const QVariant &source)
         //If a url in the form file:// is passed, take the image pointed by that from disk
         QUrl url(sourceString);
 
-        if (url.isLocalFile()) {
+        if (url.isLocalFile() && m_asynchronous) {
+            m_asyncSourceName = sourceString;
+            m_asyncRequestKey = AsyncIconLoader::self()->requestImage(this, url.path());
+        } else if (url.isLocalFile()) {
             m_icon = QIcon();
             m_imageIcon = QImage(url.path());
             m_svgIconName.clear();
             m_svgIcon.reset();
-        } else {
-            if (!m_svgIcon) {
-                m_svgIcon = std::make_unique<Plasma::Svg>(this);
-                m_svgIcon->setColorGroup(m_colorGroup);
-                m_svgIcon->setStatus(Plasma::Svg::Normal);
-                m_svgIcon->setUsingRenderingCache(false);
-                m_svgIcon->setDevicePixelRatio((window() ? window()->devicePixelRatio() : qApp->devicePixelRatio()));
-                connect(m_svgIcon.get(), &Plasma::Svg::repaintNeeded, this, &IconItem::schedulePixmapUpdate);
-            }
+        } else if (m_asynchronous) {
+            //! the current icon is shown until the new one is loaded,
+            //! so the plasma theme is checked with a new svg
+            std::unique_ptr<Plasma::Svg> svgIcon = createSvgIcon();
 
-            if (m_usesPlasmaTheme) {
-                //try as a svg icon from plasma theme
-                m_svgIcon->setImagePath(QLatin1String("icons/") + sourceString.split('-').first());
-                m_svgIcon->setContainsMultipleImages(true);
-                //invalidate the image path to recalculate it later
+            if (findInPlasmaTheme(svgIcon.get(), sourceString)) {
+                m_svgIcon = std::move(svgIcon);
+                m_icon = QIcon();
+                m_svgIconName = sourceString;
             } else {
-                m_svgIcon->setImagePath(QString());
+                //! icon theme lookups happen in a worker thread
+                m_asyncSvgIcon = std::move(svgIcon);
+                m_asyncSourceName = sourceString;
+                m_asyncRequestKey = AsyncIconLoader::self()->requestIconPath(this, sourceString, static_cast<int>(qMin(width(), height())));
+
+                if (m_asyncRequestKey.isEmpty()) {
+                    applyIconPath(sourceString, QString());
+                }
+            }
+        } else {
+            if (!m_svgIcon) {
+                m_svgIcon = createSvgIcon();
             }
 
             //success?
-            if (m_svgIcon->isValid() && m_svgIcon->hasElement(sourceString)) {
+            if (findInPlasmaTheme(m_svgIcon.get(), sourceString)) {
                 m_icon = QIcon();
                 m_svgIconName = sourceString;
                 //ok, svg not available from the plasma theme
@@ -144,22 +194,7 @@ void IconItem::setSource(const QVariant &source)
                     qWarning() << "KIconLoader has no theme set";
                 }
 
-                if (!iconPath.isEmpty()) {
-                    m_svgIcon->setImagePath(iconPath);
-                    m_svgIconName = sourceString;
-                    //fail, use QIcon
-                } else {
-                    //if we started with a QIcon use that.
-                    m_icon = source.value<QIcon>();
-
-                    if (m_icon.isNull()) {
-                        m_icon = QIcon::fromTheme(sourceString);
-                    }
-
-                    m_svgIconName.clear();
-                    m_svgIcon.reset();
-                    m_imageIcon = QImage();
-                }
+                applyIconPath(sourceString, iconPath);
             }
         }
     } else if (source.canConvert<QIcon>()) {
@@ -185,7 +220,8 @@ void IconItem::setSource(const QVariant &source)
         m_svgIcon.reset();
     }
 
-    if (width() > 0 && height() > 0) {
+    //! while loading asynchronously the previous icon is still shown
+    if (width() > 0 && height() > 0 && m_asyncRequestKey.isEmpty()) {
         schedulePixmapUpdate();
     }
 
@@ -193,6 +229,95 @@ void IconItem::setSource(const QVariant &source)
     emit validChanged();
 }
 
+std::unique_ptr<Plasma::Svg> IconItem::createSvgIcon()
+{
+    auto svgIcon = std::make_unique<Plasma::Svg>(this);
+    svgIcon->setColorGroup(m_colorGroup);
+    svgIcon->setStatus(Plasma::Svg::Normal);
+    svgIcon->setUsingRenderingCache(false);
+    svgIcon->setDevicePixelRatio((window() ? window()->devicePixelRatio() : qApp->devicePixelRatio()));
+    connect(svgIcon.get(), &Plasma::Svg::repaintNeeded, this, &IconItem::schedulePixmapUpdate);
+
+    return svgIcon;
+}
+
+bool IconItem::findInPlasmaTheme(Plasma::Svg *svgIcon, const QString &sourceString) const
+{
+    if (m_usesPlasmaTheme) {
+        //try as a svg icon from plasma theme
+        svgIcon->setImagePath(QLatin1String("icons/") + sourceString.split('-').first());
+        svgIcon->setContainsMultipleImages(true);
+        //invalidate the image path to recalculate it later
+    } else {
+        svgIcon->setImagePath(QString());
+    }
+
+    return svgIcon->isValid() && svgIcon->hasElement(sourceString);
+}
+
+void IconItem::applyIconPath(const QString &sourceString, const QString &iconPath)
+{
+    //! the svg that was prepared when the asynchronous request started
+    if (m_asyncSvgIcon) {
+        m_svgIcon = std::move(m_asyncSvgIcon);
+    }
+
+    if (!iconPath.isEmpty() && m_svgIcon) {
+        m_svgIcon->setImagePath(iconPath);
+        m_svgIconName = sourceString;
+        //fail, use QIcon
+    } else {
+        //if we started with a QIcon use that.
+        m_icon = m_source.value<QIcon>();
+
+        if (m_icon.isNull()) {
+            m_icon = QIcon::fromTheme(sourceString);
+        }
+
+        m_svgIconName.clear();
+        m_svgIcon.reset();
+        m_imageIcon = QImage();
+    }
+}
+
+void IconItem::cancelAsyncRequest()
+{
+    if (m_asyncRequestKey.isEmpty()) {
+        return;
+    }
+
+    AsyncIconLoader::self()->cancel(this, m_asyncRequestKey);
+    m_asyncRequestKey.clear();
+    m_asyncSourceName.clear();
+    m_asyncSvgIcon.reset();
+}
+
+void IconItem::onAsyncIconLoaded(const QString &key, const QString &path, const QImage &image)
+{
+    if (m_asyncRequestKey.isEmpty() || key != m_asyncRequestKey) {
+        return;
+    }
+
+    const QString sourceString = m_asyncSourceName;
+    m_asyncRequestKey.clear();
+    m_asyncSourceName.clear();
+
+    if (key.startsWith(QLatin1String("file:"))) {
+        m_icon = QIcon();
+        m_imageIcon = image;
+        m_svgIconName.clear();
+        m_svgIcon.reset();
+    } else {
+        applyIconPath(sourceString, path);
+    }
+
+    if (width() > 0 && height() > 0) {
+        schedulePixmapUpdate();
+    }
+
+    emit validChanged();
+}
+
 QVariant IconItem::source() const
 {
     return m_source;
@@ -235,6 +360,10 @@ void IconItem::setColorGroup(Plasma::Theme::ColorGroup group)
         m_svgIcon->setColorGroup(group);
     }
 
+    if (m_asyncSvgIcon) {
+        m_asyncSvgIcon->setColorGroup(group);
+    }
+
     emit colorGroupChanged();
 }
 
@@ -274,12 +403,27 @@ void IconItem::setActive(bool active)
     m_active = active;
 
     if (isComponentComplete()) {
-        schedulePixmapUpdate();
+        polish();
     }
 
     emit activeChanged();
 }
 
+bool IconItem::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+void IconItem::setAsynchronous(const bool asynchronous)
+{
+    if (m_asynchronous == asynchronous) {
+        return;
+    }
+
+    m_asynchronous = asynchronous;
+    emit asynchronousChanged();
+}
+
 bool IconItem::providesColors() const
 {
     return m_providesColors;
@@ -369,7 +513,7 @@ QSGNode *IconItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *update
             delete oldNode;
 
         textureNode = new ManagedTextureNode;
-        textureNode->setTexture(QSharedPointer<QSGTexture>(window()->createTextureFromImage(m_iconPixmap.toImage(), QQuickWindow::TextureCanUseAtlas)));
+        textureNode->setTexture(IconRegistry::self()->texture(window(), m_iconPixmap));
         textureNode->setFiltering(smooth() ? QSGTexture::Linear : QSGTexture::Nearest);
 
         m_sizeChanged = true;
@@ -388,12 +532,91 @@ QSGNode *IconItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *update
 
 void IconItem::schedulePixmapUpdate()
 {
+    //! icon contents changed, sizes that were rasterized before are not valid any more
+    clearPixmapCache();
+    m_lastColorsSourceId.clear();
     polish();
 }
 
+void IconItem::clearPixmapCache()
+{
+    //! IconItems can outlive the application during teardown
+    if (IconRegistry *registry = IconRegistry::self()) {
+        for (const auto &key : m_pixmapCacheKeys) {
+            registry->release(key);
+        }
+    }
+
+    m_pixmapCache.clear();
+    m_pixmapCacheKeys.clear();
+    m_pixmapCacheUsage.clear();
+}
+
+void IconItem::setCachedPixmap(const PixmapId &id, const QPixmap &pixmap, const QString &registryKey)
+{
+    if (m_pixmapCacheKeys.contains(id)) {
+        IconRegistry::self()->release(m_pixmapCacheKeys.take(id));
+    }
+
+    IconRegistry::self()->acquire(registryKey, pixmap);
+
+    m_pixmapCache[id] = pixmap;
+    m_pixmapCacheKeys[id] = registryKey;
+    m_pixmapCacheUsage.removeAll(id);
+    m_pixmapCacheUsage.append(id);
+
+    while (m_pixmapCacheUsage.count() > MAXCACHEDPIXMAPS) {
+        const PixmapId evicted = m_pixmapCacheUsage.takeFirst();
+        m_pixmapCache.remove(evicted);
+        IconRegistry::self()->release(m_pixmapCacheKeys.take(evicted));
+    }
+}
+
+QString IconItem::registryKey(const PixmapId &id) const
+{
+    //! while a source is loading asynchronously the previous icon is rasterized
+    //! and it must not be registered under the new source
+    if (!m_asyncRequestKey.isEmpty()
+            || m_lastLoadedSourceId.isEmpty()
+            || m_lastLoadedSourceId.startsWith(QLatin1String("_icon_"))
+            || m_lastLoadedSourceId.startsWith(QLatin1String("_image_"))) {
+        return QString();
+    }
+
+    const qreal devicePixelRatio = window() ? window()->devicePixelRatio() : qApp->devicePixelRatio();
+
+    return QStringList{m_lastLoadedSourceId,
+                QString::number(IconRegistry::self()->generation()),
+                m_usesPlasmaTheme ? QStringLiteral("plasmatheme") : QString(),
+                QString::number(id.first),
+                QString::number(devicePixelRatio),
+                QString::number(id.second),
+                QString::number(m_colorGroup),
+                m_overlays.join(QLatin1Char(','))}.join(QLatin1Char('|'));
+}
+
+int IconItem::pixmapSize() const
+{
+    const int size = static_cast<int>(qMin(width(), height()));
+
+    return m_sizeRestTimer.isActive() ? sizeBucket(size) : size;
+}
+
+IconItem::IconState IconItem::iconState() const
+{
+    if (!isEnabled()) {
+        return DisabledState;
+    } else if (m_active) {
+        return ActiveState;
+    }
+
+    return NormalState;
+}
+
 void IconItem::enabledChanged()
 {
-    schedulePixmapUpdate();
+    //! state variants are cached, the icon does not need to be rasterized again
+    polish();
 }
 
 QColor IconItem::backgroundColor() const
@@ -428,52 +651,50 @@ void IconItem::setGlowColor(QColor glow)
 
 void IconItem::updateColors()
 {
-    QImage icon = m_iconPixmap.toImage();
+    //! colors are shared between all IconItems that show the same icon, they are
+    //! always calculated from the normal state and not from the active or disabled one
+    QString key;
+    const int size = pixmapSize();
 
-    if (icon.format() != QImage::Format_Invalid) {
-        float rtotal = 0, gtotal = 0, btotal = 0;
-        float total = 0.0f;
-
-        for(int row=0; row<icon.height(); ++row) {
-            QRgb *line = (QRgb *)icon.scanLine(row);
-
-            for(int col=0; col<icon.width(); ++col) {
-                QRgb pix = line[col];
-
-                int r = qRed(pix);
-                int g = qGreen(pix);
-                int b = qBlue(pix);
-                int a = qAlpha(pix);
+    if (!m_lastLoadedSourceId.isEmpty()
+            && !m_lastLoadedSourceId.startsWith(QLatin1String("_icon_"))
+            && !m_lastLoadedSourceId.startsWith(QLatin1String("_image_"))) {
+        key = m_lastLoadedSourceId + QLatin1Char('|') + QString::number(sizeBucket(size));
+    }
 
-                float saturation = (qMax(r, qMax(g, b)) - qMin(r, qMin(g, b))) / 255.0f;
-                float relevance = .1 + .9 * (a / 255.0f) * saturation;
+    QPair<QColor, QColor> colors = IconRegistry::self()->colors(key);
 
-                rtotal += (float)(r * relevance);
-                gtotal += (float)(g * relevance);
-                btotal += (float)(b * relevance);
+    if (!colors.first.isValid()) {
+        QImage icon = basePixmap(size).toImage();
 
-                total += relevance * 255;
-            }
+        //! a small version of the icon is more than enough for its dominant color
+        if (icon.width() > MAXCOLORSLENGTH || icon.height() > MAXCOLORSLENGTH) {
+            icon = icon.scaled(MAXCOLORSLENGTH, MAXCOLORSLENGTH, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         }
 
-        int nr = (rtotal / total) * 255;
-        int ng = (gtotal / total) * 255;
-        int nb = (btotal / total) * 255;
+        QColor tempColor = Latte::weightedAverageColor(icon);
 
-        QColor tempColor(nr, ng, nb);
+        if (!tempColor.isValid()) {
+            //! it is calculated again the next time the icon is loaded
+            m_lastColorsSourceId.clear();
+            return;
+        }
 
         if (tempColor.hsvSaturationF() > 0.15f) {
             tempColor.setHsvF(tempColor.hueF(), 0.65f, tempColor.valueF());
         }
 
         tempColor.setHsvF(tempColor.hueF(), tempColor.saturationF(), 0.55f); //original 0.90f ???
-
-        setBackgroundColor(tempColor);
+        colors.first = tempColor;
 
         tempColor.setHsvF(tempColor.hueF(), tempColor.saturationF(), 1.0f);
+        colors.second = tempColor;
 
-        setGlowColor(tempColor);
+        IconRegistry::self()->setColors(key, colors);
     }
+
+    setBackgroundColor(colors.first);
+    setGlowColor(colors.second);
 }
 
 void IconItem::loadPixmap()
@@ -482,14 +703,60 @@ void IconItem::loadPixmap()
         return;
     }
 
-    const auto size = qMin(width(), height());
+    const int size = pixmapSize();
+    const PixmapId id(size, iconState());
     //final pixmap to paint
     QPixmap result;
 
-    if (size <= 0) {
+    if (size > 0 && m_pixmapCache.contains(id)) {
+        const QPixmap &cached = m_pixmapCache[id];
+
+        if (cached.cacheKey() != m_iconPixmap.cacheKey()) {
+            m_iconPixmap = cached;
+            m_textureChanged = true;
+        }
+
+        m_pixmapCacheUsage.removeAll(id);
+        m_pixmapCacheUsage.append(id);
+
+        update();
+        return;
+    }
+
+    const QString key = registryKey(id);
+
+    //! identical icons from other IconItems are not rasterized again
+    result = IconRegistry::self()->pixmap(key);
+
+    if (result.isNull()) {
+        result = stateVariant(basePixmap(size), id.second);
+    }
+
+    if (result.isNull()) {
         m_iconPixmap = QPixmap();
         update();
         return;
+    }
+
+    m_iconPixmap = result;
+    setCachedPixmap(id, result, key);
+
+    if (m_providesColors && m_asyncRequestKey.isEmpty() && m_lastLoadedSourceId != m_lastColorsSourceId) {
+        m_lastColorsSourceId = m_lastLoadedSourceId;
+        updateColors();
+    }
+
+    m_textureChanged = true;
+    //don't animate initial setting
+    update();
+}
+
+QPixmap IconItem::rasterizedPixmap(int size)
+{
+    QPixmap result;
+
+    if (size <= 0) {
+        return result;
     } else if (m_svgIcon) {
         m_svgIcon->resize(size, size);
 
@@ -501,12 +768,12 @@ void IconItem::loadPixmap()
 
             if (iconTheme) {
                 iconPath = iconTheme->iconPath(m_svgIconName + QLatin1String(".svg")
-                                               , static_cast<int>(qMin(width(), height()))
+                                               , size
                                                , KIconLoader::MatchBest);
 
                 if (iconPath.isEmpty()) {
                     iconPath = iconTheme->iconPath(m_svgIconName + QLatin1String(".svgz"),
-                                                   static_cast<int>(qMin(width(), height()))
+                                                   size
                                                    , KIconLoader::MatchBest);
                 }
             } else {
@@ -520,14 +787,12 @@ void IconItem::loadPixmap()
             result = m_svgIcon->pixmap();
         }
     } else if (!m_icon.isNull()) {
-        result = m_icon.pixmap(QSize(static_cast<int>(size), static_cast<int>(size))
+        result = m_icon.pixmap(QSize(size, size)
                                * (window() ? window()->devicePixelRatio() : qApp->devicePixelRatio()));
     } else if (!m_imageIcon.isNull()) {
         result = QPixmap::fromImage(m_imageIcon);
     } else {
-        m_iconPixmap = QPixmap();
-        update();
-        return;
+        return result;
     }
 
     // Strangely KFileItem::overlays() returns empty string-values, so
@@ -544,22 +809,40 @@ void IconItem::loadPixmap()
         }
     }
 
-    if (!isEnabled()) {
-        result = KIconLoader::global()->iconEffect()->apply(result, KIconLoader::Desktop, KIconLoader::DisabledState);
-    } else if (m_active) {
-        result = KIconLoader::global()->iconEffect()->apply(result, KIconLoader::Desktop, KIconLoader::ActiveState);
+    return result;
+}
+
+QPixmap IconItem::basePixmap(int size)
+{
+    const PixmapId id(size, NormalState);
+
+    if (m_pixmapCache.contains(id)) {
+        return m_pixmapCache[id];
     }
 
-    m_iconPixmap = result;
+    const QString key = registryKey(id);
+    QPixmap base = IconRegistry::self()->pixmap(key);
 
-    if (m_providesColors && m_lastLoadedSourceId != m_lastColorsSourceId) {
-        m_lastColorsSourceId = m_lastLoadedSourceId;
-        updateColors();
+    if (base.isNull()) {
+        base = rasterizedPixmap(size);
     }
 
-    m_textureChanged = true;
-    //don't animate initial setting
-    update();
+    if (!base.isNull()) {
+        setCachedPixmap(id, base, key);
+    }
+
+    return base;
+}
+
+QPixmap IconItem::stateVariant(const QPixmap &base, IconState state) const
+{
+    if (base.isNull() || state == NormalState) {
+        return base;
+    }
+
+    const int effectState = (state == DisabledState) ? KIconLoader::DisabledState : KIconLoader::ActiveState;
+
+    return KIconLoader::global()->iconEffect()->apply(base, KIconLoader::Desktop, effectState);
 }
 
 void IconItem::itemChange(ItemChange change, const ItemChangeData &value)
@@ -573,7 +856,12 @@ void IconItem::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeome
         m_sizeChanged = true;
 
         if (newGeometry.width() > 1 && newGeometry.height() > 1) {
-            schedulePixmapUpdate();
+            if (!m_iconPixmap.isNull()) {
+                //! size is probably animated, it is rasterized at its exact size when at rest
+                m_sizeRestTimer.start();
+            }
+
+            polish();
         } else {
             update();
         }
@@ -28,9 +28,13 @@
 
 // Qt
 #include <QQuickItem>
+#include <QHash>
 #include <QIcon>
 #include <QImage>
+#include <QList>
+#include <QPair>
 #include <QPixmap>
+#include <QTimer>
 
 // Plasma
 #include <Plasma/Svg>
@@ -103,6 +107,12 @@ class IconItem : public QQuickItem
      */
     Q_PROPERTY(bool providesColors READ providesColors WRITE setProvidesColors NOTIFY providesColorsChanged)
 
+    /**
+     * If set, icon theme lookups and image files decoding happen in worker threads
+     * and the previous icon is shown until the new one is available
+     */
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
+
     /**
      * Contains the last valid icon name
      */
@@ -134,6 +144,9 @@ public:
     bool providesColors() const;
     void setProvidesColors(const bool provides);
 
+    bool asynchronous() const;
+    void setAsynchronous(const bool asynchronous);
+
     bool usesPlasmaTheme() const;
     void setUsesPlasmaTheme(bool usesPlasmaTheme);
 
@@ -156,6 +169,7 @@ public:
 
 signals:
     void activeChanged();
+    void asynchronousChanged();
     void backgroundColorChanged();
     void colorGroupChanged();
     void glowColorChanged();
@@ -173,8 +187,40 @@ private slots:
     void enabledChanged();
 
 private:
+    enum IconState {
+        NormalState = 0,
+        ActiveState,
+        DisabledState
+    };
+
+    //! rasterized pixel size and icon state
+    typedef QPair<int, IconState> PixmapId;
+
+    std::unique_ptr<Plasma::Svg> createSvgIcon();
+    //! returns true when the plasma theme provides the icon, svgIcon is prepared for it
+    bool findInPlasmaTheme(Plasma::Svg *svgIcon, const QString &sourceString) const;
+    void applyIconPath(const QString &sourceString, const QString &iconPath);
+    void cancelAsyncRequest();
+    //! called only from AsyncIconLoader for the requests that the item waits for
+    void onAsyncIconLoaded(const QString &key, const QString &path, const QImage &image);
+
+    friend class AsyncIconLoader;
     void loadPixmap();
     void updateColors();
+    void clearPixmapCache();
+    void setCachedPixmap(const PixmapId &id, const QPixmap &pixmap, const QString &registryKey);
+
+    //! the pixel size that the icon must be rasterized at
+    int pixmapSize() const;
+    IconState iconState() const;
+    //! the icon with its overlays but without any state effect
+    QPixmap rasterizedPixmap(int size);
+    QPixmap basePixmap(int size);
+    QPixmap stateVariant(const QPixmap &base, IconState state) const;
+
+    //! identifies the rasterized icon in IconRegistry, it is empty for icons
+    //! that can not be shared e.g. QImage or unnamed QIcon sources
+    QString registryKey(const PixmapId &id) const;
     void setLastLoadedSourceId(QString id);
     void setLastValidSourceName(QString name);
     void setBackgroundColor(QColor background);
@@ -182,6 +228,7 @@ private:
 
 private:
     bool m_active;
+    bool m_asynchronous{false};
     bool m_providesColors{false};
     bool m_smooth;
 
@@ -216,12 +263,27 @@ private:
 
     QStringList m_overlays;
 
+    //! asynchronous request that the source is waiting for
+    QString m_asyncRequestKey;
+    QString m_asyncSourceName;
+    //! replaces m_svgIcon when the asynchronous request finishes
+    std::unique_ptr<Plasma::Svg> m_asyncSvgIcon;
+
     Plasma::Theme::ColorGroup m_colorGroup;
 
     //this contains the raw variant it was passed
     QVariant m_source;
 
     QSizeF m_implicitSize;
+
+    //! rasterized pixmaps per pixel size and state, while the icon size is animated e.g.
+    //! parabolic zoom the icon is drawn scaled from size buckets instead of being rasterized
+    //! for every frame. It is rasterized at its exact size only when its size is at rest.
+    //! State variants are kept so hovering or disabling an icon only switches pixmaps
+    QHash<PixmapId, QPixmap> m_pixmapCache;
+    QHash<PixmapId, QString> m_pixmapCacheKeys;
+    QList<PixmapId> m_pixmapCacheUsage;
+    QTimer m_sizeRestTimer;
 };
 
 }
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "iconregistry.h"
+
+// Qt
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QQuickWindow>
+#include <QSGTexture>
+
+// KDE
+#include <KIconThemes/KIconLoader>
+
+// Plasma
+#include <Plasma/Theme>
+
+//! colors are tiny but icons sources are not released explicitly
+#define MAXCACHEDCOLORS 1000
+
+namespace Latte {
+
+IconRegistry::IconRegistry(QObject *parent)
+    : QObject(parent),
+      m_theme(new Plasma::Theme(this))
+{
+    //! registered pixmaps are not valid any more, IconItems are rasterizing
+    //! their icons again and they are registered under a new generation
+    connect(KIconLoader::global(), &KIconLoader::iconLoaderSettingsChanged, this, &IconRegistry::invalidateIcons);
+    connect(m_theme, &Plasma::Theme::themeChanged, this, &IconRegistry::invalidateIcons);
+
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &IconRegistry::releaseResources);
+    }
+}
+
+IconRegistry::~IconRegistry()
+{
+}
+
+IconRegistry *IconRegistry::self()
+{
+    static QPointer<IconRegistry> s_registry(new IconRegistry(QCoreApplication::instance()));
+    return s_registry.data();
+}
+
+QPixmap IconRegistry::pixmap(const QString &key) const
+{
+    if (key.isEmpty() || !m_pixmaps.contains(key)) {
+        return QPixmap();
+    }
+
+    return m_pixmaps[key].pixmap;
+}
+
+void IconRegistry::acquire(const QString &key, const QPixmap &pixmap)
+{
+    if (key.isEmpty()) {
+        return;
+    }
+
+    PixmapEntry &entry = m_pixmaps[key];
+
+    if (entry.references == 0) {
+        entry.pixmap = pixmap;
+    }
+
+    entry.references++;
+}
+
+void IconRegistry::release(const QString &key)
+{
+    if (key.isEmpty() || !m_pixmaps.contains(key)) {
+        return;
+    }
+
+    PixmapEntry &entry = m_pixmaps[key];
+    entry.references--;
+
+    if (entry.references <= 0) {
+        m_pixmaps.remove(key);
+    }
+}
+
+int IconRegistry::generation() const
+{
+    return m_generation;
+}
+
+void IconRegistry::invalidateIcons()
+{
+    //! pixmaps are reference counted from IconItems and they are not cleared in place
+    m_generation++;
+    m_colors.clear();
+
+    emit iconsInvalidated();
+}
+
+void IconRegistry::releaseResources()
+{
+    m_colors.clear();
+
+    {
+        QMutexLocker locker(&m_texturesMutex);
+
+        for (auto &textures : m_textures) {
+            textures.clear();
+        }
+    }
+
+    delete m_theme;
+    m_theme = nullptr;
+}
+
+void IconRegistry::dropTextures(QQuickWindow *window, bool windowDestroyed)
+{
+    QMutexLocker locker(&m_texturesMutex);
+
+    //! windows that are still alive keep their table in order to not connect them again
+    if (windowDestroyed) {
+        m_textures.remove(window);
+    } else if (m_textures.contains(window)) {
+        m_textures[window].clear();
+    }
+}
+
+QPair<QColor, QColor> IconRegistry::colors(const QString &key) const
+{
+    if (key.isEmpty()) {
+        return QPair<QColor, QColor>();
+    }
+
+    return m_colors.value(key);
+}
+
+void IconRegistry::setColors(const QString &key, const QPair<QColor, QColor> &colors)
+{
+    if (key.isEmpty()) {
+        return;
+    }
+
+    if (m_colors.count() >= MAXCACHEDCOLORS) {
+        m_colors.clear();
+    }
+
+    m_colors[key] = colors;
+}
+
+QSharedPointer<QSGTexture> IconRegistry::texture(QQuickWindow *window, const QPixmap &pixmap)
+{
+    if (!window || pixmap.isNull()) {
+        return QSharedPointer<QSGTexture>();
+    }
+
+    QMutexLocker locker(&m_texturesMutex);
+
+    if (!m_textures.contains(window)) {
+        //! direct connections, the table must be gone before the window address can be reused
+        connect(window, &QObject::destroyed, this, [this, window]() {
+            dropTextures(window, true);
+        }, Qt::DirectConnection);
+        connect(window, &QQuickWindow::sceneGraphInvalidated, this, [this, window]() {
+            dropTextures(window, false);
+        }, Qt::DirectConnection);
+    }
+
+    QHash<qint64, QWeakPointer<QSGTexture>> &textures = m_textures[window];
+    QSharedPointer<QSGTexture> texture = textures.value(pixmap.cacheKey()).toStrongRef();
+
+    if (texture) {
+        return texture;
+    }
+
+    //! textures that are not used from any node any more
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it.value().isNull()) {
+            it = textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    texture = QSharedPointer<QSGTexture>(window->createTextureFromImage(pixmap.toImage(), QQuickWindow::TextureCanUseAtlas));
+    textures[pixmap.cacheKey()] = texture;
+
+    return texture;
+}
+
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026  agent <agent@local>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATTEICONREGISTRY_H
+#define LATTEICONREGISTRY_H
+
+// Qt
+#include <QColor>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QPixmap>
+#include <QSharedPointer>
+#include <QWeakPointer>
+
+class QQuickWindow;
+class QSGTexture;
+
+namespace Plasma {
+class Theme;
+}
+
+namespace Latte {
+
+//! Process wide registry of rasterized icons. Identical icons that are shown
+//! from different IconItems, e.g. the same launcher in many docks, are
+//! rasterized only once and share their pixmap data. Textures of identical
+//! pixmaps are also shared between the IconItems of the same window.
+//! The registry is owned from the application, nullptr is returned after
+//! the application is destroyed.
+class IconRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IconRegistry *self();
+    ~IconRegistry() override;
+
+    //! returns a null pixmap when no IconItem has rasterized the icon yet
+    QPixmap pixmap(const QString &key) const;
+
+    //! every acquired key must be released when its pixmap is not used any more,
+    //! pixmaps are removed when they are not used from any IconItem
+    void acquire(const QString &key, const QPixmap &pixmap);
+    void release(const QString &key);
+
+    //! it is increased when the icon or the plasma theme changes, it is part of the
+    //! registry keys so pixmaps of the previous themes are never served again
+    int generation() const;
+
+    //! it is used from render threads
+    QSharedPointer<QSGTexture> texture(QQuickWindow *window, const QPixmap &pixmap);
+
+    //! background and glow colors of icons, invalid colors are returned
+    //! when they have not been calculated yet
+    QPair<QColor, QColor> colors(const QString &key) const;
+    void setColors(const QString &key, const QPair<QColor, QColor> &colors);
+
+signals:
+    //! icons must be rasterized again and registered under the new generation
+    void iconsInvalidated();
+
+private slots:
+    void invalidateIcons();
+    //! the theme and all cached icons are released when the application quits
+    void releaseResources();
+
+private:
+    IconRegistry(QObject *parent = nullptr);
+
+    //! textures of windows that were destroyed or lost their scene graph
+    void dropTextures(QQuickWindow *window, bool windowDestroyed);
+
+private:
+    struct PixmapEntry {
+        QPixmap pixmap;
+        int references{0};
+    };
+
+    int m_generation{0};
+
+    //! entries of previous generations are removed when their last IconItem releases them
+    QHash<QString, PixmapEntry> m_pixmaps;
+    QHash<QString, QPair<QColor, QColor>> m_colors;
+
+    //! window, pixmap cache key, texture
+    QHash<QQuickWindow *, QHash<qint64, QWeakPointer<QSGTexture>>> m_textures;
+    QMutex m_texturesMutex;
+
+    Plasma::Theme *m_theme{nullptr};
+};
+
+}
+
+#endif
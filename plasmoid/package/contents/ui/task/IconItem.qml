@@ -159,6 +159,7 @@ Item{
             height: width
 
             source: decoration
+            asynchronous: true
             smooth: taskItem.parabolic.factor.zoom === 1 ? true : false
             providesColors: indicators ? indicators.info.needsIconColors : false
 